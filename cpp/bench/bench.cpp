@@ -0,0 +1,365 @@
+/* Micro-benchmarks for the estimators and the kernels that they are built on.
+ *
+ * Each benchmark is run on synthetic data (of a configurable size, word size and bias) repeatedly, until it has
+ * run for at least the minimum time. The throughput is reported in samples per second, where the samples are the
+ * symbols (for the literal benchmarks), the bits (for the bitstring benchmarks) or the simulated samples (for the
+ * restart simulation). The results can be saved as a baseline, and later runs compared against it.
+ */
+
+#include "../shared/utils.h"
+#include "../shared/most_common.h"
+#include "../shared/lrs_test.h"
+#include "../iid/iid_test_run.h"
+#include "../non_iid/collision_test.h"
+#include "../non_iid/lz78y_test.h"
+#include "../non_iid/multi_mmc_test.h"
+#include "../non_iid/lag_test.h"
+#include "../non_iid/multi_mcw_test.h"
+#include "../non_iid/compression_test.h"
+#include "../non_iid/markov_test.h"
+#include "../iid/chi_square_tests.h"
+#include "../iid/permutation_tests.h"
+#include "../shared/restart_simulation.h"
+
+#include <getopt.h>
+#include <limits.h>
+#include <fstream>
+#include <sstream>
+
+#define BENCH_DEFAULT_SAMPLES 1000000L
+#define BENCH_DEFAULT_MIN_TIME 0.5
+//The data (and everything random within the benchmarks) is derived from this seed, so runs are comparable
+#define BENCH_SEED 0x5890bULL
+//A change of more than this fraction (relative to the baseline) is flagged
+#define BENCH_REPORT_THRESHOLD 0.05
+
+[[ noreturn ]] void print_usage() {
+    printf("Usage is: ea_bench [-n <samples>] [-w <bits_per_symbol>] [-p <bias>] [-m <seconds>] [-f <filter>] [-b <baseline>] [-s <baseline>]\n\n");
+    printf("\t -n <samples>: The number of synthetic samples (default %ld).\n", BENCH_DEFAULT_SAMPLES);
+    printf("\t -w <bits_per_symbol>: The width of each sample, between 1-8, inclusive (default 8).\n");
+    printf("\t -p <bias>: The probability that each bit of a sample is 1 (default 0.5).\n");
+    printf("\t -m <seconds>: Run each benchmark for at least this long (default %.1f). Each benchmark is run at least once.\n", BENCH_DEFAULT_MIN_TIME);
+    printf("\t -f <filter>: Only run the benchmarks whose name contains <filter>.\n");
+    printf("\t -b <baseline>: Compare the results against the baseline file <baseline>. If this file doesn't exist, the results\n");
+    printf("\t\t are saved to it.\n");
+    printf("\t -s <baseline>: Save the results to the baseline file <baseline>.\n");
+    printf("\n");
+    printf("\t The throughput is reported in samples/s; for the bitstring benchmarks, each bit is a sample, and for the\n");
+    printf("\t restart simulation, each simulated sample is counted.\n");
+    printf("\n");
+    exit(-1);
+}
+
+// The synthetic data, laid out as read_file_subset would produce it
+struct benchInput {
+    data_t data;
+    double rawmean;
+    double median;
+    long simulationRounds;
+};
+
+static void benchMakeData(benchInput &in, long len, int word_size, double bias) {
+    uint64_t xoshiro256starstarState[4];
+    int symbol_map_down_table[256] = {0};
+    data_t *dp = &in.data;
+
+    seed(xoshiro256starstarState);
+
+    dp->word_size = word_size;
+    dp->len = len;
+    dp->rawsymbols = (uint8_t*)malloc(len);
+    dp->symbols = (uint8_t*)malloc(len);
+    assert((dp->rawsymbols != NULL) && (dp->symbols != NULL));
+
+    dp->maxsymbol = 0;
+    for (long i = 0; i < len; i++) {
+        uint8_t symbol = 0;
+        for (int j = 0; j < word_size; j++) {
+            if (randomUnit(xoshiro256starstarState) < bias) symbol |= (uint8_t)(1 << j);
+        }
+        dp->rawsymbols[i] = symbol;
+        dp->symbols[i] = symbol;
+        if (symbol > dp->maxsymbol) dp->maxsymbol = symbol;
+        symbol_map_down_table[symbol] = 1;
+    }
+
+    dp->alph_size = 0;
+    for (int i = 0; i < 256; i++) {
+        if (symbol_map_down_table[i] != 0) symbol_map_down_table[i] = dp->alph_size++;
+    }
+
+    dp->blen = len * word_size;
+    if (word_size == 1) {
+        dp->bsymbols = dp->symbols;
+    } else {
+        dp->bsymbols = (uint8_t*)malloc(dp->blen);
+        assert(dp->bsymbols != NULL);
+        for (long i = 0; i < len; i++) {
+            for (int j = 0; j < word_size; j++) {
+                dp->bsymbols[i * word_size + j] = (dp->symbols[i] >> (word_size - 1 - j)) & 0x1;
+            }
+        }
+    }
+
+    if (dp->alph_size < dp->maxsymbol + 1) {
+        for (long i = 0; i < len; i++) dp->symbols[i] = (uint8_t)symbol_map_down_table[dp->symbols[i]];
+    }
+
+    calc_stats(dp, in.rawmean, in.median);
+
+    // Each round of the simulation draws 1000 samples
+    in.simulationRounds = max(len / 1000, 1000L);
+}
+
+#define BENCH_LITERAL 0
+#define BENCH_BITSTRING 1
+#define BENCH_SIMULATION 2
+
+struct benchmark {
+    const char *name;
+    int samples; // Which samples the throughput is reported in (BENCH_LITERAL, BENCH_BITSTRING or BENCH_SIMULATION)
+    void (*run)(benchInput &in);
+};
+
+// The results are accumulated here, so that the calls can't be optimized away
+static volatile double benchSink;
+
+static void benchAllTests(bool *test_status) {
+    for (unsigned int i = 0; i < num_tests; i++) test_status[i] = true;
+}
+
+static const benchmark benchmarks[] = {
+    // Non-IID estimators (SP 800-90B Section 6.3)
+    {"most_common/literal", BENCH_LITERAL, [](benchInput &in) { benchSink += most_common(in.data.symbols, in.data.len, in.data.alph_size, 0, "Literal"); }},
+    {"most_common/bitstring", BENCH_BITSTRING, [](benchInput &in) { benchSink += most_common(in.data.bsymbols, in.data.blen, 2, 0, "Bitstring"); }},
+    {"collision_test/bitstring", BENCH_BITSTRING, [](benchInput &in) { benchSink += collision_test(in.data.bsymbols, in.data.blen, 0, "Bitstring"); }},
+    {"markov_test/bitstring", BENCH_BITSTRING, [](benchInput &in) { benchSink += markov_test(in.data.bsymbols, in.data.blen, 0, "Bitstring"); }},
+    {"compression_test/bitstring", BENCH_BITSTRING, [](benchInput &in) { benchSink += compression_test(in.data.bsymbols, in.data.blen, 0, "Bitstring"); }},
+    {"SAalgs/literal", BENCH_LITERAL, [](benchInput &in) {
+        double t_tuple_res = -1.0, lrs_res = -1.0;
+        SAalgs(in.data.symbols, in.data.len, in.data.alph_size, t_tuple_res, lrs_res, 0, "Literal");
+        benchSink += t_tuple_res + lrs_res;
+    }},
+    {"SAalgs/bitstring", BENCH_BITSTRING, [](benchInput &in) {
+        double t_tuple_res = -1.0, lrs_res = -1.0;
+        SAalgs(in.data.bsymbols, in.data.blen, 2, t_tuple_res, lrs_res, 0, "Bitstring");
+        benchSink += t_tuple_res + lrs_res;
+    }},
+    {"multi_mcw_test/literal", BENCH_LITERAL, [](benchInput &in) { benchSink += multi_mcw_test(in.data.symbols, in.data.len, in.data.alph_size, 0, "Literal"); }},
+    {"multi_mcw_test/bitstring", BENCH_BITSTRING, [](benchInput &in) { benchSink += multi_mcw_test(in.data.bsymbols, in.data.blen, 2, 0, "Bitstring"); }},
+    {"lag_test/literal", BENCH_LITERAL, [](benchInput &in) { benchSink += lag_test(in.data.symbols, in.data.len, in.data.alph_size, 0, "Literal"); }},
+    {"lag_test/bitstring", BENCH_BITSTRING, [](benchInput &in) { benchSink += lag_test(in.data.bsymbols, in.data.blen, 2, 0, "Bitstring"); }},
+    {"multi_mmc_test/literal", BENCH_LITERAL, [](benchInput &in) { benchSink += multi_mmc_test(in.data.symbols, in.data.len, in.data.alph_size, 0, "Literal"); }},
+    {"multi_mmc_test/bitstring", BENCH_BITSTRING, [](benchInput &in) { benchSink += multi_mmc_test(in.data.bsymbols, in.data.blen, 2, 0, "Bitstring"); }},
+    {"LZ78Y_test/literal", BENCH_LITERAL, [](benchInput &in) { benchSink += LZ78Y_test(in.data.symbols, in.data.len, in.data.alph_size, 0, "Literal"); }},
+    {"LZ78Y_test/bitstring", BENCH_BITSTRING, [](benchInput &in) { benchSink += LZ78Y_test(in.data.bsymbols, in.data.blen, 2, 0, "Bitstring"); }},
+
+    // IID tests (SP 800-90B Section 5)
+    {"len_LRS_test/literal", BENCH_LITERAL, [](benchInput &in) { benchSink += len_LRS_test(in.data.symbols, in.data.len, in.data.alph_size, 0, "Literal"); }},
+    {"chi_square_tests/literal", BENCH_LITERAL, [](benchInput &in) { benchSink += chi_square_tests(in.data.symbols, in.data.len, in.data.alph_size, 0); }},
+
+    // The permutation test statistics (one permutation's worth)
+    {"permutation/excursion", BENCH_LITERAL, [](benchInput &in) {
+        long double stats[num_tests]; bool test_status[num_tests];
+        benchAllTests(test_status);
+        excursion_test(in.data.rawsymbols, in.rawmean, in.data.len, stats, test_status);
+        benchSink += (double)stats[0];
+    }},
+    {"permutation/directional", BENCH_LITERAL, [](benchInput &in) {
+        long double stats[num_tests]; bool test_status[num_tests];
+        benchAllTests(test_status);
+        directional_tests(in.data.symbols, in.data.alph_size, in.data.len, stats, test_status);
+        benchSink += (double)stats[1];
+    }},
+    {"permutation/consecutive_runs", BENCH_LITERAL, [](benchInput &in) {
+        long double stats[num_tests]; bool test_status[num_tests];
+        benchAllTests(test_status);
+        consecutive_runs_tests(in.data.symbols, in.median, in.data.alph_size, in.data.len, stats, test_status);
+        benchSink += (double)stats[4];
+    }},
+    {"permutation/collision", BENCH_LITERAL, [](benchInput &in) {
+        long double stats[num_tests]; bool test_status[num_tests];
+        benchAllTests(test_status);
+        collision_tests(in.data.symbols, in.data.alph_size, in.data.len, stats, test_status);
+        benchSink += (double)stats[6];
+    }},
+    {"permutation/periodicity", BENCH_LITERAL, [](benchInput &in) {
+        long double stats[num_tests]; bool test_status[num_tests];
+        benchAllTests(test_status);
+        periodicity_tests(in.data.symbols, in.data.alph_size, in.data.len, stats, test_status);
+        benchSink += (double)stats[8];
+    }},
+    {"permutation/covariance", BENCH_LITERAL, [](benchInput &in) {
+        long double stats[num_tests]; bool test_status[num_tests];
+        benchAllTests(test_status);
+        covariance_tests((in.data.alph_size == 2) ? in.data.symbols : in.data.rawsymbols, in.data.alph_size, in.data.len, stats, test_status);
+        benchSink += (double)stats[13];
+    }},
+    {"permutation/compression", BENCH_LITERAL, [](benchInput &in) {
+        long double stats[num_tests]; bool test_status[num_tests];
+        benchAllTests(test_status);
+        compression_test(in.data.rawsymbols, in.data.len, stats, in.data.maxsymbol, test_status);
+        benchSink += (double)stats[18];
+    }},
+    {"permutation/run_tests", BENCH_LITERAL, [](benchInput &in) {
+        long double stats[num_tests]; bool test_status[num_tests];
+        benchAllTests(test_status);
+        run_tests(&in.data, in.data.symbols, in.data.rawsymbols, in.rawmean, in.median, stats, test_status);
+        benchSink += (double)stats[0];
+    }},
+    {"permutation/FYshuffle", BENCH_LITERAL, [](benchInput &in) {
+        uint64_t xoshiro256starstarState[4];
+        xoshiroBulkState rng;
+        vector<uint8_t> data(in.data.symbols, in.data.symbols + in.data.len);
+        vector<uint8_t> rawdata(in.data.rawsymbols, in.data.rawsymbols + in.data.len);
+
+        seed(xoshiro256starstarState);
+        xoshiroBulkInit(rng, xoshiro256starstarState);
+        FYshuffle(data.data(), rawdata.data(), in.data.len, rng);
+        benchSink += data[0];
+    }},
+
+    // The restart sanity check simulation (SP 800-90B Section 3.1.4.3)
+    {"restart/simulateBound", BENCH_SIMULATION, [](benchInput &in) {
+        benchSink += simulateBound(1 - exp(log(0.99) / 2000.0), 1 << in.data.word_size, in.data.word_size / 2.0, in.simulationRounds);
+    }},
+};
+
+static bool benchReadBaseline(const char *path, map<string, double> &baseline) {
+    ifstream input(path);
+    string line;
+
+    if (!input.is_open()) return false;
+
+    while (getline(input, line)) {
+        istringstream fields(line);
+        string name;
+        double rate;
+
+        if (line.empty() || (line[0] == '#')) continue;
+        if (fields >> name >> rate) baseline[name] = rate;
+    }
+
+    return true;
+}
+
+static void benchWriteBaseline(const char *path, const vector< pair<string, double> > &results, long len, int word_size, double bias) {
+    ofstream output(path);
+
+    output << "# ea_bench baseline: " << len << " samples, " << word_size << " bit(s) per symbol, bias " << bias << ", " << omp_get_max_threads() << " thread(s)" << endl;
+    output << "# name samples/s" << endl;
+    for (size_t i = 0; i < results.size(); i++) {
+        output << results[i].first << " " << setprecision(6) << results[i].second << endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    long len = BENCH_DEFAULT_SAMPLES;
+    int word_size = 8;
+    double bias = 0.5;
+    double minTime = BENCH_DEFAULT_MIN_TIME;
+    const char *filter = NULL;
+    const char *baselinePath = NULL;
+    const char *savePath = NULL;
+    char *nextOption;
+    int opt;
+    benchInput in;
+    map<string, double> baseline;
+    bool haveBaseline = false;
+    vector< pair<string, double> > results;
+    int regressions = 0;
+
+    while ((opt = getopt(argc, argv, "n:w:p:m:f:b:s:")) != -1) {
+        switch (opt) {
+            case 'n':
+                len = strtol(optarg, &nextOption, 0);
+                if ((len < 1) || (len > INT_MAX) || (*nextOption != '\0')) print_usage();
+                break;
+            case 'w':
+                word_size = atoi(optarg);
+                if ((word_size < 1) || (word_size > 8)) print_usage();
+                break;
+            case 'p':
+                bias = strtod(optarg, &nextOption);
+                if ((bias <= 0.0) || (bias >= 1.0) || (*nextOption != '\0')) print_usage();
+                break;
+            case 'm':
+                minTime = strtod(optarg, &nextOption);
+                if ((minTime < 0.0) || (*nextOption != '\0')) print_usage();
+                break;
+            case 'f':
+                filter = optarg;
+                break;
+            case 'b':
+                baselinePath = optarg;
+                break;
+            case 's':
+                savePath = optarg;
+                break;
+            default:
+                print_usage();
+        }
+    }
+
+    if (optind != argc) print_usage();
+
+    setFixedSeed(BENCH_SEED);
+    benchMakeData(in, len, word_size, bias);
+
+    if (baselinePath != NULL) {
+        haveBaseline = benchReadBaseline(baselinePath, baseline);
+        if (!haveBaseline) savePath = baselinePath;
+    }
+
+    printf("Running benchmarks on %ld samples of %d distinct %d-bit-wide symbols (bias %g) using %d thread(s)\n", len, in.data.alph_size, word_size, bias, omp_get_max_threads());
+    if (haveBaseline) printf("Comparing against the baseline in '%s'\n", baselinePath);
+    printf("\n%-32s %10s %14s %14s %10s\n", "Benchmark", "Iterations", "Time/iter (s)", "Samples/s", "Change");
+
+    for (size_t b = 0; b < sizeof(benchmarks) / sizeof(benchmarks[0]); b++) {
+        const benchmark &bench = benchmarks[b];
+        long samples;
+        long iterations = 0;
+        double start, elapsed;
+        double rate;
+
+        if ((filter != NULL) && (strstr(bench.name, filter) == NULL)) continue;
+
+        if (bench.samples == BENCH_LITERAL) samples = in.data.len;
+        else if (bench.samples == BENCH_BITSTRING) samples = in.data.blen;
+        else samples = in.simulationRounds * 1000;
+
+        start = timingWallSeconds();
+        do {
+            bench.run(in);
+            iterations++;
+            elapsed = timingWallSeconds() - start;
+        } while (elapsed < minTime);
+
+        rate = ((double)samples * (double)iterations) / elapsed;
+        results.push_back(make_pair(string(bench.name), rate));
+
+        printf("%-32s %10ld %14.6f %14.4g", bench.name, iterations, elapsed / (double)iterations, rate);
+        if (haveBaseline && (baseline.count(bench.name) != 0)) {
+            const double change = rate / baseline[bench.name] - 1.0;
+            printf(" %+9.1f%%", 100.0 * change);
+            if (change < -BENCH_REPORT_THRESHOLD) {
+                printf(" (slower)");
+                regressions++;
+            } else if (change > BENCH_REPORT_THRESHOLD) {
+                printf(" (faster)");
+            }
+        }
+        printf("\n");
+        fflush(stdout);
+    }
+
+    if (haveBaseline) printf("\n%d benchmark(s) more than %.0f%% slower than the baseline\n", regressions, 100.0 * BENCH_REPORT_THRESHOLD);
+
+    if (savePath != NULL) {
+        benchWriteBaseline(savePath, results, len, word_size, bias);
+        printf("\nSaved the results to the baseline '%s'\n", savePath);
+    }
+
+    free_data(&in.data);
+    return 0;
+}
@@ -1,4 +1,4 @@
-/* VERSION information is kept in utils.h. Please update when a new version is released */
+/* VERSION information is kept in shared/data.h. Please update when a new version is released */
 
 #include "non_iid/collision_test.h"
 #include "non_iid/lz78y_test.h"
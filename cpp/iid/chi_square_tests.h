@@ -58,7 +58,7 @@ static double PI     = 3.14159265358979323846;         // pi, duh!
 static double big = 4.503599627370496e15;
 static double biginv =  2.22044604925031308085e-16;
 
-static int sgngam = 0;
+static thread_local int sgngam = 0;
 
 /* A[]: Stirling's formula expansion of log gamma
  * B[], C[]: log gamma function between 2 and 3
@@ -420,10 +420,38 @@ void allocate_bins(vector<struct tupleTranslateEntry> &e, vector<double> &bin_ex
 	}
 }
 
+/* The (non-overlapping) pairs are first counted by tuple, and then each tuple's count is added to its bin.
+ * As in histogram, the pairs are counted into several interleaved tables so that repeated pairs don't result
+ * in a chain of dependent increments. e must be ordered by tuple.
+ */
 void independence_calc_observed(const uint8_t data[], const vector<struct tupleTranslateEntry> &e, vector<int> &o, const int sample_size, const int alphabet_size){
-	for(int j = 0; j < sample_size-1; j+=2){
-		uint16_t index = (uint16_t)((data[j] * alphabet_size) + data[j+1]);
-		o[e[index].bin]++;
+	const int tupleCount = alphabet_size * alphabet_size;
+	const int subCount = (tupleCount <= 4096) ? 4 : 2;
+	vector<uint32_t> sub((size_t)subCount * tupleCount, 0);
+	int j = 0;
+
+	assert(e.size() == (size_t)tupleCount);
+
+	if(subCount == 4) {
+		for(; j + 7 < sample_size; j += 8){
+			sub[(data[j] * alphabet_size) + data[j+1]]++;
+			sub[tupleCount + (data[j+2] * alphabet_size) + data[j+3]]++;
+			sub[2*tupleCount + (data[j+4] * alphabet_size) + data[j+5]]++;
+			sub[3*tupleCount + (data[j+6] * alphabet_size) + data[j+7]]++;
+		}
+	} else {
+		for(; j + 3 < sample_size; j += 4){
+			sub[(data[j] * alphabet_size) + data[j+1]]++;
+			sub[tupleCount + (data[j+2] * alphabet_size) + data[j+3]]++;
+		}
+	}
+	for(; j < sample_size-1; j+=2) sub[(data[j] * alphabet_size) + data[j+1]]++;
+
+	for(int t = 0; t < tupleCount; t++){
+		uint32_t count = 0;
+		for(int k = 0; k < subCount; k++) count += sub[(size_t)k * tupleCount + t];
+		assert(e[t].tuple == t);
+		o[e[t].bin] += (int)count;
 	}
 }
 
@@ -443,8 +471,12 @@ double calc_T(const vector<double> &bin_expectations, const vector<int> &o){
 }
 
 void goodness_of_fit_calc_observed(const uint8_t data[], const vector<struct tupleTranslateEntry> &e, vector<int> &o, const int sample_size){
-	for(int j = 0; j < sample_size; j++){
-		o[e[data[j]].bin]++;
+	long counts[256];
+
+	//The symbols are counted first, and then each symbol's count goes to its bin
+	histogram(data, sample_size, e.size(), counts);
+	for(unsigned int j = 0; j < e.size(); j++){
+		o[e[j].bin] += (int)counts[j];
 	}
 }
 
@@ -524,8 +556,58 @@ bool expectationOrder(const struct tupleTranslateEntry &a, const struct tupleTra
 	else return a.tuple < b.tuple;
 }
 
-bool tupleOrder(const struct tupleTranslateEntry &a, const struct tupleTranslateEntry &b){
-	return a.tuple < b.tuple;
+/* Sorts e by expectation (from smallest to largest) and then by tuple value, as expectationOrder, using an LSD radix sort.
+ * The expectations are non-negative, so their ordering is the same as the ordering of their bit patterns.
+ * Each pass is stable, and e starts off ordered by tuple value, so ties are resolved by tuple.
+ */
+void sortByExpectation(vector<struct tupleTranslateEntry> &e){
+	vector<struct tupleTranslateEntry> tmp(e.size());
+	vector<uint64_t> keys(e.size()), tmpKeys(e.size());
+
+	for(size_t i = 0; i < e.size(); i++){
+		assert(e[i].expectation >= 0.0);
+		assert((i == 0) || (e[i-1].tuple < e[i].tuple));
+		memcpy(&keys[i], &e[i].expectation, sizeof(uint64_t));
+	}
+
+	for(int shift = 0; shift < 64; shift += 8){
+		size_t counts[256] = {0};
+		size_t offset = 0;
+
+		for(size_t i = 0; i < e.size(); i++) counts[(keys[i] >> shift) & 0xFF]++;
+
+		//If every entry has the same digit, this pass wouldn't change anything.
+		if(counts[(keys[0] >> shift) & 0xFF] == e.size()) continue;
+
+		for(int b = 0; b < 256; b++){
+			size_t count = counts[b];
+			counts[b] = offset;
+			offset += count;
+		}
+
+		for(size_t i = 0; i < e.size(); i++){
+			size_t dest = counts[(keys[i] >> shift) & 0xFF]++;
+			tmp[dest] = e[i];
+			tmpKeys[dest] = keys[i];
+		}
+
+		e.swap(tmp);
+		keys.swap(tmpKeys);
+	}
+
+	assert(is_sorted(e.begin(), e.end(), expectationOrder));
+}
+
+//Restores the tuple ordering (so e can be used as a lookup table). The tuples are just 0 ... e.size()-1.
+void sortByTuple(vector<struct tupleTranslateEntry> &e){
+	vector<struct tupleTranslateEntry> tmp(e.size());
+
+	for(size_t i = 0; i < e.size(); i++){
+		assert(e[i].tuple < e.size());
+		tmp[e[i].tuple] = e[i];
+	}
+
+	e.swap(tmp);
 }
 
 void chi_square_independence(const uint8_t data[], double &score, int &df,  const int sample_size, const int alphabet_size){
@@ -537,15 +619,15 @@ void chi_square_independence(const uint8_t data[], double &score, int &df,  cons
 	vector<struct tupleTranslateEntry> e(alphabet_size*alphabet_size);
 	independence_calc_expectations(p, e, sample_size);
 	//Sort by expectation, from smallest to largest. Secondary sort on tuple value, from smallest to largest
-	sort(e.begin(), e.end(), expectationOrder);
+	sortByExpectation(e);
 
 	// Allocate sorted expected values into bins and accumulate corresponding expected values of entire bins
 	vector<double> bin_expectations;
 	allocate_bins(e, bin_expectations);
 
 	//Sort by tuple, from smallest to largest, so we can use this as a lookup table
-	sort(e.begin(), e.end(), tupleOrder);
-	
+	sortByTuple(e);
+
 	// Calculate the observed frequency of each pair of symbols
 	vector<int> o(bin_expectations.size(), 0);
 	independence_calc_observed(data, e, o, sample_size, alphabet_size);
@@ -607,14 +689,14 @@ void goodness_of_fit(const uint8_t data[], double &score, int &df, const int sam
 	}
 
         //Sort by expectation, from smallest to largest. Secondary sort on tuple value, from smallest to largest
-        sort(e.begin(), e.end(), expectationOrder);
+        sortByExpectation(e);
 
         // Allocate sorted expected values into bins and accumulate corresponding expected values of entire bins
         vector<double> bin_expectations;
         allocate_bins(e, bin_expectations);
 
         //Sort by tuple, from smallest to largest, so we can use this as a lookup table
-        sort(e.begin(), e.end(), tupleOrder);
+        sortByTuple(e);
 
 	// Calculate the observed frequency of each symbol in each subset
 	int block_size = sample_size/10;
@@ -632,12 +714,13 @@ void goodness_of_fit(const uint8_t data[], double &score, int &df, const int sam
 	df = 9*(bin_expectations.size()-1);
 }
 
-bool chi_square_tests(const uint8_t data[], const int sample_size, const int alphabet_size, const int verbose){
+bool chi_square_tests(const uint8_t data[], const int sample_size, const int alphabet_size, const int verbose, PhaseTimings *phases = NULL){
 
 	double score = 0.0;
 	double pvalue;
 	int df = 0;
 	bool result = true;
+	PhaseTimer chiSquareTimer("Chi square tests", phases);
 
 	// Chi Square independence test
 	if(alphabet_size == 2){
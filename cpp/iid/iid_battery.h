@@ -0,0 +1,178 @@
+#pragma once
+#include "../shared/utils.h"
+#include "../shared/most_common.h"
+#include "../shared/lrs_test.h"
+#include "iid_test_case.h"
+#include "permutation_tests.h"
+#include "chi_square_tests.h"
+#include <omp.h>
+
+// Runs the IID tests of Section 5 (the permutation tests, the chi square tests and the LRS test) on the (loaded
+// and translated) data, and records the results in tc, along with the most common value estimate of Section 6.3.1.
+// The permutation tests use (at most) threads threads. The phases timed are added to phases (if not NULL).
+// Returns true if the data passes all of the tests, and false otherwise (including when the data has fewer than
+// 2 distinct symbols).
+bool iidBattery(data_t *dp, bool initial_entropy, int verbose, int threads, IidTestCase &tc, PhaseTimings *phases = NULL) {
+	double rawmean, median;
+
+	if (dp->alph_size <= 1) return false;
+
+	// Calculate baseline statistics
+	int alphabet_size = dp->alph_size;
+	int sample_size = dp->len;
+
+	if ((verbose == 1) || (verbose == 2))
+		printf("Calculating baseline statistics...\n");
+
+	calc_stats(dp, rawmean, median);
+
+	if (verbose == 2) {
+		printf("\tRaw Mean: %f\n", rawmean);
+		printf("\tMedian: %f\n", median);
+		printf("\tBinary: %s\n\n", (alphabet_size == 2 ? "true" : "false"));
+	} else if (verbose > 2) {
+		printf("Raw Mean = %.17g\n", rawmean);
+		printf("Median = %.17g\n", median);
+		printf("Binary = %s\n", (alphabet_size == 2 ? "true" : "false"));
+	}
+
+	PhaseTimer tcTimer(tc.timing);
+	tc.mean = rawmean;
+	tc.median = median;
+	tc.binary = (alphabet_size == 2);
+
+	double H_original = dp->word_size;
+	double H_bitstring = 1.0;
+
+	// Compute the min-entropy of the dataset
+	if (initial_entropy) {
+		H_original = most_common(dp->symbols, sample_size, alphabet_size, verbose, "Literal");
+	}
+	tc.h_original = H_original;
+
+	if (((dp->alph_size > 2) || !initial_entropy)) {
+		H_bitstring = most_common(dp->bsymbols, dp->blen, 2, verbose, "Bitstring");
+	}
+	tc.h_bitstring = H_bitstring;
+
+	double h_assessed = dp->word_size;
+	if ((verbose == 1) || (verbose == 2)) {
+		if (initial_entropy) {
+			printf("H_original: %f\n", H_original);
+			if (dp->alph_size > 2) {
+				printf("H_bitstring: %f\n", H_bitstring);
+				printf("min(H_original, %d X H_bitstring): %f\n", dp->word_size, min(H_original, dp->word_size * H_bitstring));
+			}
+		} else {
+			printf("h': %f\n", H_bitstring);
+		}
+	} else if (verbose > 2) {
+		h_assessed = dp->word_size;
+
+		if ((dp->alph_size > 2) || !initial_entropy) {
+			h_assessed = min(h_assessed, H_bitstring * dp->word_size);
+			printf("H_bitstring = %.17g\n", H_bitstring);
+			printf("H_bitstring Per Symbol = %.17g\n", H_bitstring * dp->word_size);
+		}
+
+		if (initial_entropy) {
+			h_assessed = min(h_assessed, H_original);
+			printf("H_original = %.17g\n", H_original);
+		}
+
+		printf("Assessed min entropy: %.17g\n", h_assessed);
+	}
+	tc.h_assessed = h_assessed;
+
+	bool chi_square_test_pass, len_LRS_test_pass, perm_test_pass;
+
+	// The chi square and LRS tests are independent of the permutation tests, so when there is more than one
+	// thread available, they are run in a separate thread while the permutation tests are running.
+	// At higher verbosity levels, each of the tests prints its intermediate results, so these are run in order.
+	// The caller's OpenMP settings are restored afterwards (this may be running within another program).
+	int callerThreads = omp_get_max_threads();
+	int callerActiveLevels = omp_get_max_active_levels();
+
+	if ((threads > 1) && (verbose <= 1)) {
+		omp_set_max_active_levels(2);
+
+		#pragma omp parallel sections num_threads(2)
+		{
+			#pragma omp section
+			{
+				omp_set_num_threads(1);
+				chi_square_test_pass = chi_square_tests(dp->symbols, sample_size, alphabet_size, verbose, phases);
+				len_LRS_test_pass = len_LRS_test(dp->symbols, sample_size, alphabet_size, verbose, "Literal", phases);
+			}
+
+			#pragma omp section
+			{
+				omp_set_num_threads(threads);
+				perm_test_pass = permutation_tests(dp, rawmean, median, verbose, tc, 0, phases);
+			}
+		}
+	} else {
+		omp_set_num_threads(threads);
+		chi_square_test_pass = chi_square_tests(dp->symbols, sample_size, alphabet_size, verbose, phases);
+		len_LRS_test_pass = len_LRS_test(dp->symbols, sample_size, alphabet_size, verbose, "Literal", phases);
+		perm_test_pass = permutation_tests(dp, rawmean, median, verbose, tc, 0, phases);
+	}
+
+	omp_set_num_threads(callerThreads);
+	omp_set_max_active_levels(callerActiveLevels);
+
+	// Report the chi square stats
+	tc.passed_chi_square_tests = chi_square_test_pass;
+
+	if ((verbose == 1) || (verbose == 2)) {
+		if (chi_square_test_pass) {
+			printf("** Passed chi square tests\n\n");
+		} else {
+			printf("** Failed chi square tests\n\n");
+		}
+	} else if (verbose > 2) {
+		if (chi_square_test_pass) {
+			printf("Chi square tests: Passed\n");
+		} else {
+			printf("Chi square tests: Failed\n");
+		}
+	}
+
+	// Report the length of the longest repeated substring stats
+	tc.passed_longest_repeated_substring_test = len_LRS_test_pass;
+
+	if ((verbose == 1) || (verbose == 2)) {
+		if (len_LRS_test_pass) {
+			printf("** Passed length of longest repeated substring test\n\n");
+		} else {
+			printf("** Failed length of longest repeated substring test\n\n");
+		}
+	} else if (verbose > 2) {
+		if (len_LRS_test_pass) {
+			printf("Length of longest repeated substring test: Passed\n");
+		} else {
+			printf("Length of longest repeated substring test: Failed\n");
+		}
+	}
+
+	// Report the permutation stats
+	tc.passed_iid_permutation_tests = perm_test_pass;
+
+	if ((verbose == 1) || (verbose == 2)) {
+		if (perm_test_pass) {
+			printf("** Passed IID permutation tests\n\n");
+		} else {
+			printf("** Failed IID permutation tests\n\n");
+		}
+	} else if (verbose > 2) {
+		if (perm_test_pass) {
+			printf("IID permutation tests: Passed\n");
+		} else {
+			printf("IID permutation tests: Failed\n");
+		}
+	}
+
+	tcTimer.Stop();
+
+	return chi_square_test_pass && len_LRS_test_pass && perm_test_pass;
+}
@@ -25,6 +25,18 @@ public:
         return styled.write(json);
     }
 
+    // Prints the recorded phases, and then the cost of each test case (used for the --profile option)
+    void PrintTiming() {
+        TestRunBase::PrintBaseTiming();
+
+        printf("\nTest case timing:\n");
+        for (int i = 0; i < (int)testCases.size(); i++){
+            if (!testCases[i].timing.recorded) continue;
+            if (testCases[i].testCaseNumber.empty()) testCases[i].timing.Print(("Test case " + to_string(i)).c_str());
+            else testCases[i].timing.Print(testCases[i].testCaseNumber.c_str());
+        }
+    }
+
     const bool IID = true;
     vector<IidTestCase> testCases;
 };
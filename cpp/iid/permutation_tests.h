@@ -572,7 +572,7 @@ void populateTestCase(IidTestCase &tc, int C[][3]){
     tc.testResults.push_back(tr2);
 }
 
-bool permutation_tests(const data_t *dp, const double rawmean, const double median, const int verbose, IidTestCase &tc){
+bool permutation_tests(const data_t *dp, const double rawmean, const double median, const int verbose, IidTestCase &tc, uint64_t seedStream = 0, PhaseTimings *phases = NULL){
 	uint64_t xoshiro256starstarMainSeed[4];
 	bool istty;
 
@@ -600,9 +600,11 @@ bool permutation_tests(const data_t *dp, const double rawmean, const double medi
 
 	// Run initial tests
 	if(verbose == 2) cout << "Beginning initial tests..." << endl;
-	seed(xoshiro256starstarMainSeed);
+	seed(xoshiro256starstarMainSeed, seedStream);
 
+	PhaseTimer initialTimer("Permutation initial tests", phases);
 	run_tests(dp, dp->symbols, dp->rawsymbols, rawmean, median, t, test_status);
+	initialTimer.Stop();
 
 	if(verbose == 2) {
 		cout << endl << "Initial test results" << endl;
@@ -619,13 +621,30 @@ bool permutation_tests(const data_t *dp, const double rawmean, const double medi
 	
 	if(verbose == 2) cout << "Beginning permutation tests... these may take some time" << endl;
 
+	/* Each permutation i is generated from its own RNG stream (the main seed jumped i times) starting from the
+	 * original data, and the results are aggregated in permutation order (as they would be if the permutations were
+	 * run one after another). As such, the results depend only on the seed, and not on the number of threads or the
+	 * order in which the threads finish.
+	 * outcome[i][j] is the result of comparing test j for permutation i to the original result (0 for >, 1 for =, 2 for <),
+	 * or -1 if the test wasn't run. A test is always run for permutation i unless the in-order aggregation of some
+	 * prior permutations has already concluded that test, so the outcomes needed for the aggregation are present.
+	 */
+	vector< array<int8_t, num_tests> > outcome(PERMS);
+	vector<bool> ready(PERMS, false);
+	int aggregated = 0; // The number of permutations aggregated into C
+	int passed_count = 0;
+	PhaseTimer loopTimer("Permutation loop", phases);
+
 	#pragma omp parallel
 	{
 		uint8_t *data;
 		uint8_t *rawdata;
 		uint64_t xoshiro256starstarSeed[4];
+		int streamIndex; // The stream currently in xoshiro256starstarSeed
+		xoshiroBulkState rng;
 		long double tp[num_tests];
-		int passed_count;
+		bool run_status[num_tests]; // A (possibly out of date) copy of test_status
+		int local_passed_count;
 
 		data = new uint8_t[dp->len];
 		rawdata = new uint8_t[dp->len];
@@ -633,47 +652,59 @@ bool permutation_tests(const data_t *dp, const double rawmean, const double medi
 		// Init results
 		for(unsigned int i = 0; i < num_tests; ++i){
 			tp[i] = -1;
+			run_status[i] = true;
 		}
 
-		for(int i = 0; i < dp->len; ++i){
-			data[i] = dp->symbols[i];
-			rawdata[i] = dp->rawsymbols[i];
-		}
-
-		passed_count = 0;
+		local_passed_count = 0;
 		memcpy(xoshiro256starstarSeed, xoshiro256starstarMainSeed, sizeof(xoshiro256starstarMainSeed));
-		//Cause the RNG to jump omp_get_thread_num() * 2^128 calls
-		xoshiro_jump(omp_get_thread_num(), xoshiro256starstarSeed);
+		streamIndex = 0;
 
-		#pragma omp for
+		#pragma omp for schedule(dynamic)
 		for(int i = 0; i < PERMS; ++i) {
-			if(passed_count < 19) {
+			if(local_passed_count < 19) {
 				char statusMessage[1024];
 				size_t statusMessageLength = 0;
 
-				FYshuffle(data, rawdata, dp->len, xoshiro256starstarSeed);
-				run_tests(dp, data, rawdata, rawmean, median, tp, test_status);
+				//Each thread is assigned increasing permutation indices, so only a few jumps are needed to reach stream i.
+				assert(streamIndex <= i);
+				xoshiro_jump(i - streamIndex, xoshiro256starstarSeed);
+				streamIndex = i;
+				xoshiroBulkInit(rng, xoshiro256starstarSeed);
+
+				memcpy(data, dp->symbols, dp->len);
+				memcpy(rawdata, dp->rawsymbols, dp->len);
+				FYshuffle(data, rawdata, dp->len, rng);
+				run_tests(dp, data, rawdata, rawmean, median, tp, run_status);
+
+				for(unsigned int j = 0; j < num_tests; ++j){
+					if(!run_status[j]) outcome[i][j] = -1;
+					else if(tp[j] > t[j]) outcome[i][j] = 0;
+					else if(tp[j] == t[j]) outcome[i][j] = 1;
+					else outcome[i][j] = 2;
+				}
 
-				// Aggregate results into the counters
+				// Aggregate results into the counters, in permutation order
 				#pragma omp critical(resultUpdate)
 				{
-					for(unsigned int j = 0; j < num_tests; ++j){
-						if(test_status[j]) {
-							if(tp[j] > t[j]){
-								C[j][0]++;
-							} else if(tp[j] == t[j]){
-								C[j][1]++;
-							} else {
-								C[j][2]++;
-							}
-							if((C[j][0] + C[j][1] > 5) && (C[j][1] + C[j][2] > 5)) {
-								test_status[j] = false;
+					ready[i] = true;
+					while((aggregated < PERMS) && ready[aggregated] && (passed_count < 19)) {
+						for(unsigned int j = 0; j < num_tests; ++j){
+							if(test_status[j]) {
+								assert(outcome[aggregated][j] >= 0);
+								C[j][outcome[aggregated][j]]++;
+								if((C[j][0] + C[j][1] > 5) && (C[j][1] + C[j][2] > 5)) {
+									test_status[j] = false;
+								}
 							}
 						}
+						passed_count = 0;
+						for(unsigned int j=0; j < num_tests; j++) if(!test_status[j]) passed_count++;
+						aggregated++;
 					}
-					passed_count = 0;
-					for(unsigned int j=0; j < num_tests; j++) if(!test_status[j]) passed_count++;
 					completed ++;
+
+					local_passed_count = passed_count;
+					memcpy(run_status, test_status, sizeof(run_status));
 				} // end resultUpdate
 
 				if(verbose == 2) {
@@ -693,7 +724,7 @@ bool permutation_tests(const data_t *dp, const double rawmean, const double medi
 						statusMessageLength = 0;
 					}
 
-					res = snprintf(statusMessage+statusMessageLength, sizeof(statusMessage)-statusMessageLength, "%6.02f%% of Permutation test rounds, %6.02f%% of Permutation tests", (100.0*((float)completed)/((float)PERMS)), (100.0*((float)passed_count)/19.0));
+					res = snprintf(statusMessage+statusMessageLength, sizeof(statusMessage)-statusMessageLength, "%6.02f%% of Permutation test rounds, %6.02f%% of Permutation tests", (100.0*((float)completed)/((float)PERMS)), (100.0*((float)local_passed_count)/19.0));
 					assert(res>0);
 					statusMessageLength += res;
 					assert(statusMessageLength < sizeof(statusMessage));
@@ -703,7 +734,7 @@ bool permutation_tests(const data_t *dp, const double rawmean, const double medi
 					* output looks nicer. 
 					*/
 					if(!istty)  {
-						res = snprintf(statusMessage+statusMessageLength, sizeof(statusMessage)-statusMessageLength, " (Core %d/%d, passed_count %d)\n", omp_get_thread_num(), omp_get_num_threads()-1, passed_count);
+						res = snprintf(statusMessage+statusMessageLength, sizeof(statusMessage)-statusMessageLength, " (Core %d/%d, passed_count %d)\n", omp_get_thread_num(), omp_get_num_threads()-1, local_passed_count);
 						assert(res>0);
 						statusMessageLength += res;
 						assert(statusMessageLength < sizeof(statusMessage));
@@ -724,6 +755,7 @@ bool permutation_tests(const data_t *dp, const double rawmean, const double medi
         	delete[](data);
         	delete[](rawdata);
 	} //end parallel
+	loopTimer.Stop();
 
 	if(verbose > 1) print_results(C, verbose);
         
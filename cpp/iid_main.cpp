@@ -1,13 +1,7 @@
-/* VERSION information is kept in utils.h. Please update when a new version is released */
+/* VERSION information is kept in shared/data.h. Please update when a new version is released */
 
 
-#include "shared/utils.h"
-#include "shared/most_common.h"
-#include "shared/lrs_test.h"
-#include "iid/iid_test_run.h"
-#include "shared/TestRunUtils.h"
-#include "iid/permutation_tests.h"
-#include "iid/chi_square_tests.h"
+#include "lib/entropy_assessment.h"
 #include <openssl/sha.h>
 #include <omp.h>
 #include <getopt.h>
@@ -18,7 +12,7 @@
 
 
 [[ noreturn ]] void print_usage() {
-    printf("Usage is: ea_iid [-i|-c] [-a|-t] [-v] [-q] [-l <index>,<samples> ] <file_name> [bits_per_symbol]\n\n");
+    printf("Usage is: ea_iid [-i|-c] [-a|-t] [-v] [-q] [-j <threads>] [--seed <hex>] [--profile] [-l <index>,<samples> ] <file_name> [bits_per_symbol]\n\n");
     printf("\t <file_name>: Must be relative path to a binary file with at least 1 million entries (samples).\n");
     printf("\t [bits_per_symbol]: Must be between 1-8, inclusive. By default this value is inferred from the data.\n");
     printf("\t [-i|-c]: '-i' for initial entropy estimate, '-c' for conditioned sequential dataset entropy estimate. The initial entropy estimate is the default.\n");
@@ -27,6 +21,12 @@
     printf("\t -v: Optional verbosity flag for more output. Can be used multiple times.\n");
     printf("\t -q: Quiet mode, less output to screen. This will override any verbose flags.\n");
     printf("\t -l <index>,<samples>\tRead the <index> substring of length <samples>.\n");
+    printf("\t -j <threads>: Use (at most) <threads> threads for the permutation tests. By default, all available cores are used.\n");
+    printf("\t\t When more than one thread is used (and the verbosity is at most 1), the chi square and LRS tests\n");
+    printf("\t\t run in one additional thread while the permutation tests are running.\n");
+    printf("\t --seed <hex>: Seed the random number generator with the (hexadecimal) value <hex>, rather than from /dev/urandom.\n");
+    printf("\t\t Runs with the same seed produce the same results, regardless of the number of threads used.\n");
+    printf("\t --profile: Print the time and memory used by each phase and each test. These are always included in the JSON output.\n");
     printf("\n");
     printf("\t Samples are assumed to be packed into 8-bit values, where the least significant 'bits_per_symbol'\n");
     printf("\t bits constitute the symbol.\n");
@@ -60,7 +60,6 @@ int main(int argc, char* argv[]) {
 
     bool initial_entropy, all_bits;
     int verbose = 1; //verbose 0 is for JSON output, 1 is the normal mode, 2 is the NIST tool verbose mode, and 3 is for extra verbose output
-    double rawmean, median;
     char* file_path;
     data_t data;
     int opt;
@@ -68,6 +67,14 @@ int main(int argc, char* argv[]) {
     unsigned long subsetSize = 0;
     unsigned long long inint;
     char *nextOption;
+    int threads = omp_get_max_threads();
+    uint64_t fixedSeed;
+    bool profile = false;
+    static const struct option longOptions[] = {
+        {"seed", required_argument, NULL, 'S'},
+        {"profile", no_argument, NULL, 'P'},
+        {NULL, 0, NULL, 0}
+    };
 
     data.word_size = 0;
     initial_entropy = true;
@@ -91,7 +98,7 @@ int main(int argc, char* argv[]) {
         }
     }
 
-    while ((opt = getopt(argc, argv, "icatvl:qo:")) != -1) {
+    while ((opt = getopt_long(argc, argv, "icatvl:qo:j:", longOptions, NULL)) != -1) {
         switch (opt) {
             case 'i':
                 initial_entropy = true;
@@ -143,6 +150,25 @@ int main(int argc, char* argv[]) {
 
                 subsetSize = inint;
                 break;
+            case 'j':
+                inint = strtoull(optarg, &nextOption, 0);
+                if ((inint < 1) || (inint > INT_MAX) || (nextOption == NULL) || (*nextOption != '\0')) {
+                    printf("Invalid thread count: %s.\n", optarg);
+                    print_usage();
+                }
+                threads = (int)inint;
+                omp_set_num_threads(threads);
+                break;
+            case 'S':
+                if (!parseFixedSeed(optarg, fixedSeed)) {
+                    printf("Invalid seed '%s'.\n", optarg);
+                    print_usage();
+                }
+                setFixedSeed(fixedSeed);
+                break;
+            case 'P':
+                profile = true;
+                break;
             case 'q':
                 quietMode = true;
                 break;
@@ -196,7 +222,7 @@ int main(int argc, char* argv[]) {
 
     // Record hash of input file
     char hash[2*SHA256_DIGEST_LENGTH+1];
-    sha256_file(file_path, hash);
+    sha256_file(file_path, hash, &testRun.phases);
     testRun.sha256 = hash;
 
     if (verbose > 1) {
@@ -245,130 +271,13 @@ int main(int argc, char* argv[]) {
         if (data.alph_size < (1 << data.word_size)) printf("\nSamples have been translated\n");
     }
 
-    // Calculate baseline statistics
-    int alphabet_size = data.alph_size;
-    int sample_size = data.len;
-
-    if ((verbose == 1) || (verbose == 2))
-        printf("Calculating baseline statistics...\n");
-
-    calc_stats(&data, rawmean, median);
-
-    if (verbose == 2) {
-        printf("\tRaw Mean: %f\n", rawmean);
-        printf("\tMedian: %f\n", median);
-        printf("\tBinary: %s\n\n", (alphabet_size == 2 ? "true" : "false"));
-    } else if (verbose > 2) {
-        printf("Raw Mean = %.17g\n", rawmean);
-        printf("Median = %.17g\n", median);
-        printf("Binary = %s\n", (alphabet_size == 2 ? "true" : "false"));
-    }
-
     IidTestCase tc;
-    tc.mean = rawmean;
-    tc.median = median;
-    tc.binary = (alphabet_size == 2);
-
-    double H_original = data.word_size;
-    double H_bitstring = 1.0;
-
-    // Compute the min-entropy of the dataset
-    if (initial_entropy) {
-        H_original = most_common(data.symbols, sample_size, alphabet_size, verbose, "Literal");
-    }
-    tc.h_original = H_original;
-
-    if (((data.alph_size > 2) || !initial_entropy)) {
-        H_bitstring = most_common(data.bsymbols, data.blen, 2, verbose, "Bitstring");
-    }
-    tc.h_bitstring = H_bitstring;
-
-    double h_assessed = data.word_size;
-    if ((verbose == 1) || (verbose == 2)) {
-        if (initial_entropy) {
-            printf("H_original: %f\n", H_original);
-            if (data.alph_size > 2) {
-                printf("H_bitstring: %f\n", H_bitstring);
-                printf("min(H_original, %d X H_bitstring): %f\n", data.word_size, min(H_original, data.word_size * H_bitstring));
-            }
-        } else {
-            printf("h': %f\n", H_bitstring);
-        }
-    } else if (verbose > 2) {
-        h_assessed = data.word_size;
-
-        if ((data.alph_size > 2) || !initial_entropy) {
-            h_assessed = min(h_assessed, H_bitstring * data.word_size);
-            printf("H_bitstring = %.17g\n", H_bitstring);
-            printf("H_bitstring Per Symbol = %.17g\n", H_bitstring * data.word_size);
-        }
-
-        if (initial_entropy) {
-            h_assessed = min(h_assessed, H_original);
-            printf("H_original = %.17g\n", H_original);
-        }
-
-        printf("Assessed min entropy: %.17g\n", h_assessed);
-    }
-    tc.h_assessed = h_assessed;
-
-    // Compute chi square stats
-    bool chi_square_test_pass = chi_square_tests(data.symbols, sample_size, alphabet_size, verbose);
-    tc.passed_chi_square_tests = chi_square_test_pass;
-
-    if ((verbose == 1) || (verbose == 2)) {
-        if (chi_square_test_pass) {
-            printf("** Passed chi square tests\n\n");
-        } else {
-            printf("** Failed chi square tests\n\n");
-        }
-    } else if (verbose > 2) {
-        if (chi_square_test_pass) {
-            printf("Chi square tests: Passed\n");
-        } else {
-            printf("Chi square tests: Failed\n");
-        }
-    }
-
-    // Compute length of the longest repeated substring stats
-    bool len_LRS_test_pass = len_LRS_test(data.symbols, sample_size, alphabet_size, verbose, "Literal");
-    tc.passed_longest_repeated_substring_test = len_LRS_test_pass;
-
-    if ((verbose == 1) || (verbose == 2)) {
-        if (len_LRS_test_pass) {
-            printf("** Passed length of longest repeated substring test\n\n");
-        } else {
-            printf("** Failed length of longest repeated substring test\n\n");
-        }
-    } else if (verbose > 2) {
-        if (len_LRS_test_pass) {
-            printf("Length of longest repeated substring test: Passed\n");
-        } else {
-            printf("Length of longest repeated substring test: Failed\n");
-        }
-    }
-
-    // Compute permutation stats
-    bool perm_test_pass = permutation_tests(&data, rawmean, median, verbose, tc);
-    tc.passed_iid_permutation_tests = perm_test_pass;
-
-    if ((verbose == 1) || (verbose == 2)) {
-        if (perm_test_pass) {
-            printf("** Passed IID permutation tests\n\n");
-        } else {
-            printf("** Failed IID permutation tests\n\n");
-        }
-    } else if (verbose > 2) {
-        if (perm_test_pass) {
-            printf("IID permutation tests: Passed\n");
-        } else {
-            printf("IID permutation tests: Failed\n");
-        }
-    }
-
+    iidBattery(&data, initial_entropy, verbose, threads, tc, &testRun.phases);
     testRun.testCases.push_back(tc);
     testRun.errorLevel = 0;
 
+    if (profile) testRun.PrintTiming();
+
     if (jsonOutput) {
         ofstream output;
         output.open(outputfilename);
@@ -0,0 +1,59 @@
+// libentropyassessment: the single translation unit that holds the definitions of the functions declared in entropy_assessment.h
+
+#include "../shared/utils.h"
+#include "../shared/TestRunUtils.h"
+#include "../shared/restart_simulation.h"
+#include "../non_iid/non_iid_battery.h"
+#include "../iid/iid_battery.h"
+
+// Included last, as some of its declarations omit the default arguments given by the definitions above
+#include "entropy_assessment.h"
+
+// The buffer assessments take the steps that ea_non_iid and ea_iid take once the data is loaded.
+double nonIidAssessBuffer(const uint8_t *buffer, long len, int word_size, bool initial_entropy, bool all_bits, int verbose, NonIidTestRun &testRun) {
+	data_t data;
+	double h_assessed;
+
+	data.word_size = word_size;
+	if(!view_buffer(buffer, len, &data, &testRun)) return -1.0;
+
+	if(data.alph_size <= 1) {
+		testRun.errorLevel = -1;
+		testRun.errorMsg = "Symbol alphabet consists of 1 symbol. No entropy awarded...";
+		free_data_view(&data);
+		return -1.0;
+	}
+
+	if(!all_bits && (data.blen > MIN_SIZE)) data.blen = MIN_SIZE;
+
+	h_assessed = nonIidBattery(&data, initial_entropy, verbose, testRun.testCases, &testRun.phases);
+	testRun.errorLevel = 0;
+
+	free_data_view(&data);
+	return h_assessed;
+}
+
+bool iidAssessBuffer(const uint8_t *buffer, long len, int word_size, bool initial_entropy, bool all_bits, int verbose, int threads, IidTestRun &testRun) {
+	data_t data;
+	IidTestCase tc;
+	bool passed;
+
+	data.word_size = word_size;
+	if(!view_buffer(buffer, len, &data, &testRun)) return false;
+
+	if(data.alph_size <= 1) {
+		testRun.errorLevel = -1;
+		testRun.errorMsg = "Symbol alphabet consists of 1 symbol. No entropy awarded...";
+		free_data_view(&data);
+		return false;
+	}
+
+	if(!all_bits && (data.blen > MIN_SIZE)) data.blen = MIN_SIZE;
+
+	passed = iidBattery(&data, initial_entropy, verbose, threads, tc, &testRun.phases);
+	testRun.testCases.push_back(tc);
+	testRun.errorLevel = 0;
+
+	free_data_view(&data);
+	return passed;
+}
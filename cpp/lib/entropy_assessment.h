@@ -0,0 +1,92 @@
+#ifndef ENTROPY_ASSESSMENT_H
+#define ENTROPY_ASSESSMENT_H
+
+/* The API of libentropyassessment (built with "make lib").
+ *
+ * The headers under shared/, iid/ and non_iid/ define (rather than declare) their functions, so they can only be
+ * included by a single translation unit; the library is that translation unit (lib/entropy_assessment.cpp).
+ * Programs that link with the library include only this header, which declares the functions that they may call,
+ * along with the headers that hold just types (data_t, the test case and test run classes, and PhaseTimer).
+ * The functions that time phases of a run add them to the PhaseTimings passed in (normally the phases of the test
+ * run), which may be NULL.
+ *
+ * Typical use, for samples in a file:
+ *
+ *     data_t data;
+ *     data.word_size = 0; // infer the symbol width from the data
+ *     if (!read_file_subset(path, &data, ULONG_MAX, 0, &testRun)) ...
+ *     double h = nonIidBattery(&data, true, 1, testRun.testCases, &testRun.phases);
+ *     free_data(&data);
+ *
+ * and for samples in memory:
+ *
+ *     double h = nonIidAssessBuffer(samples, len, 0, true, true, 0, testRun);
+ */
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "../shared/data.h"
+#include "../shared/timing.h"
+#include "../non_iid/non_iid_test_run.h"
+#include "../iid/iid_test_run.h"
+
+using namespace std;
+
+// Loading data (see shared/utils.h). Each read_file function allocates the buffers of *dp, which are released using free_data.
+bool read_file_subset(const char *file_path, data_t *dp, unsigned long subsetIndex, unsigned long subsetSize, TestRunBase *testRun);
+bool read_file(const char *file_path, data_t *dp, TestRunBase *testRun);
+void free_data(data_t *dp);
+// Describing samples that are already in memory, without copying them (see view_buffer)
+bool view_buffer(const uint8_t *buffer, long len, data_t *dp, TestRunBase *testRun);
+void free_data_view(data_t *dp);
+void calc_stats(const data_t *dp, double &rawmean, double &median);
+void histogram(const uint8_t *data, long len, int alph_size, long *counts);
+
+// Run metadata (see shared/TestRunUtils.h and shared/utils.h)
+int sha256_file(const char *path, char *outputBuffer, PhaseTimings *phases);
+string getCurrentTimestamp();
+string recreateCommandLine(int argc, char* argv[]);
+void printVersion(string name);
+
+// Seeding the random number generator used by the permutation tests and the restart simulation (see seed)
+void setFixedSeed(uint64_t value);
+bool parseFixedSeed(const char *arg, uint64_t &value);
+
+// The non-IID estimators (Section 6.3). Each returns the min-entropy estimate per symbol, or a negative value if the estimate could not be made.
+double most_common(uint8_t* data, const long len, const int alph_size, const int verbose, const char *label);
+double most_common(uint8_t* data, const long len, const int alph_size, const int verbose, const char *label, TestCaseBase &tc);
+double collision_test(uint8_t* data, long len, const int verbose, const char *label);
+double markov_test(uint8_t* data, long len, const int verbose, const char *label);
+double compression_test(uint8_t* data, long len, const int verbose, const char *label);
+void SAalgs(const uint8_t text[], long int n, int k, double &t_tuple_res, double &lrs_res, const int verbose, const char *label, PhaseTimings *phases);
+double multi_mcw_test(uint8_t *data, long len, int alph_size, const int verbose, const char *label);
+double lag_test(uint8_t *S, long L, int k, const int verbose, const char *label);
+double multi_mmc_test(uint8_t *data, long len, int alph_size, const int verbose, const char *label);
+double LZ78Y_test(uint8_t *data, long len, int alph_size, const int verbose, const char *label);
+
+// The IID tests (Section 5). seedStream selects the random stream used for the shuffles (0 unless several sets of permutation tests are run).
+bool chi_square_tests(const uint8_t data[], const int sample_size, const int alphabet_size, const int verbose, PhaseTimings *phases);
+bool len_LRS_test(const uint8_t data[], const int L, const int k, const int verbose, const char *label, PhaseTimings *phases);
+bool permutation_tests(const data_t *dp, const double rawmean, const double median, const int verbose, IidTestCase &tc, uint64_t seedStream, PhaseTimings *phases);
+
+// The restart sanity check cutoff (Section 3.1.4.3; see shared/restart_simulation.h)
+int simulateBound(double alpha, int k, double H_I, unsigned long int simulation_rounds);
+
+// The assessments made by ea_non_iid and ea_iid (see non_iid/non_iid_battery.h and iid/iid_battery.h)
+double nonIidBattery(data_t *dp, bool initial_entropy, int verbose, vector<NonIidTestCase> &testCases, PhaseTimings *phases);
+bool iidBattery(data_t *dp, bool initial_entropy, int verbose, int threads, IidTestCase &tc, PhaseTimings *phases);
+
+/* The same assessments, made on the len samples in a caller-owned buffer (e.g., samples that were just captured), with
+ * word_size bits per sample (or 0, to infer this from the data). The samples are not copied (see view_buffer).
+ * As for ea_non_iid and ea_iid, all_bits is false to truncate the bitstring to MIN_SIZE bits (the -t option).
+ * The test cases are added to testRun, and its errorLevel and errorMsg are set.
+ * The phases timed are added to testRun.phases, so several assessments may be made at once.
+ * nonIidAssessBuffer returns the assessed min-entropy per symbol (or -1.0 on error), and iidAssessBuffer returns true
+ * if the samples pass all of the IID tests (and false if they fail any of them, or on error).
+ */
+double nonIidAssessBuffer(const uint8_t *buffer, long len, int word_size, bool initial_entropy, bool all_bits, int verbose, NonIidTestRun &testRun);
+bool iidAssessBuffer(const uint8_t *buffer, long len, int word_size, bool initial_entropy, bool all_bits, int verbose, int threads, IidTestRun &testRun);
+
+#endif /* ENTROPY_ASSESSMENT_H */
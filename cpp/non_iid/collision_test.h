@@ -12,6 +12,42 @@ double col_exp(double p){
 	return (p/(q*q))*(1.0 + 0.5*(1.0/p - 1.0/q))*F(q) - (p/q)*0.5*(1.0/p - 1.0/q);
 }
 
+/* The wait times only depend on the bits, so the bitstring is packed and consumed 16 bits at a time.
+ * For each 16-bit value (with the first bit as bit 0), the table holds the number of wait times of length 2 and 3
+ * that start within these bits (continuing as long as the next wait time lies entirely within them),
+ * and the position where the next wait time starts.
+ */
+#define COLLISION_WINDOW 16
+
+struct collisionStep {
+	uint8_t n2;
+	uint8_t n3;
+	uint8_t advance;
+};
+
+static vector<collisionStep> buildCollisionTable(){
+	vector<collisionStep> table(1 << COLLISION_WINDOW);
+
+	for(uint32_t bits = 0; bits < (1U << COLLISION_WINDOW); bits++){
+		collisionStep step = {0, 0, 0};
+		int i = 0;
+
+		while(i + 3 <= COLLISION_WINDOW){
+			if(((bits >> i) & 1) == ((bits >> (i+1)) & 1)) {
+				step.n2++;
+				i += 2;
+			} else {
+				step.n3++;
+				i += 3;
+			}
+		}
+		step.advance = (uint8_t)i;
+		table[bits] = step;
+	}
+
+	return table;
+}
+
 // Section 6.3.2 - Collision Estimate
 // data is assumed to be binary (e.g., bit string)
 double collision_test(uint8_t* data, long len, const int verbose, const char *label){
@@ -19,12 +55,23 @@ double collision_test(uint8_t* data, long len, const int verbose, const char *la
 	int t_v;
 	double X, s, p;
 	double entEst;
+	vector<uint64_t> packed;
+	static const vector<collisionStep> table = buildCollisionTable();
 
 	i = 0;
 	v = 0;
 	s = 0.0;
 
-	// compute wait times until collisions
+	// compute wait times until collisions, first using the table while the window is within the string
+	packBits(data, len, packed);
+	while(i + COLLISION_WINDOW <= len){
+		const collisionStep step = table[extractBits(packed.data(), i) & ((1U << COLLISION_WINDOW) - 1)];
+
+		v += step.n2 + step.n3;
+		s += 4*step.n2 + 9*step.n3;
+		i += step.advance;
+	}
+
 	while(i < len-1){
 		if(data[i] == data[i+1]) t_v = 2; // 00 or 11
 		else if(i < len-2) t_v = 3; // 101, 011, 100, or 101
@@ -10,11 +10,27 @@ inline void kahan_add(double &sum, double &comp, double in){
 	sum = t;
 }
 
+//log2 values for blocks beyond this are calculated as needed, rather than being stored (this caps the table at 16 MB).
+#define G_LOG2_TABLE_MAX (1L << 20)
+
+//G and com_exp are evaluated many times during the search for p, and the log2 terms in G don't depend on z,
+//so they are calculated once. log2Table[i] = log2l(i), for i < log2Table.size().
+static void initG(vector<long double> &log2Table, long num_blocks){
+	long tableSize = (num_blocks+1 < G_LOG2_TABLE_MAX) ? (num_blocks+1) : G_LOG2_TABLE_MAX;
+
+	log2Table.resize(tableSize);
+	for(long i=0; i<tableSize; i++) log2Table[i] = log2l((long double)i);
+}
+
+static inline long double Glog2(const vector<long double> &log2Table, long i){
+	return (i < (long)log2Table.size()) ? log2Table[i] : log2l((long double)i);
+}
+
 //There is some cleverness associated with this calculation of G; in particular,
 //one doesn't need to calculate all the terms independently (they are inter-related!)
 //See UL's implementation comments here: https://bit.ly/UL90BCOM 
 //Look in the section "Compression Estimate G Function Calculation"
-double G(double z, int d, long num_blocks){
+double G(double z, int d, long num_blocks, const vector<long double> &log2Table){
 	double Ai=0.0, Ai_comp=0.0;
 	double firstSum=0.0, firstSum_comp=0.0;
 	long v = num_blocks - d;
@@ -38,7 +54,7 @@ double G(double z, int d, long num_blocks){
 	//Calculate A_{d+1}
 	for(int i=2; i<=d; i++) {
 		//calculate the a_i term
-		kahan_add(Ai, Ai_comp, log2l((long double)i)*Bi);
+		kahan_add(Ai, Ai_comp, Glog2(log2Table, i)*Bi);
 
 		//Calculate B_{i+1}
 		Bi *= Bterm;
@@ -51,7 +67,7 @@ double G(double z, int d, long num_blocks){
 	//Now calculate A_{num_blocks} and the sum of sums term (firstsum)
 	for(long i=d+1; i<=num_blocks-1; i++) {
 		//calculate the a_i term
-		ai = log2l((long double)i)*Bi;
+		ai = Glog2(log2Table, i)*Bi;
 
 		//Calculate A_{i+1}
 		kahan_add(Ai, Ai_comp, (double)ai);
@@ -76,16 +92,40 @@ double G(double z, int d, long num_blocks){
 
 	//Calculate A_{num_blocks+1}
 	if(!underflowTruncate) {
-		ai = log2l((long double)num_blocks)*Bi;
+		ai = Glog2(log2Table, num_blocks)*Bi;
 		kahan_add(Ai, Ai_comp, (double)ai);
 	}
 
 	return 1/(double)v * z*(z*firstSum + (Ai - Ad1));
 }
 
-double com_exp(double p, unsigned int alph_size, int d, long num_blocks){
+//Distances below this use a table of log2 values.
+#define COMPRESSION_LOG2_TABLE_SIZE 4096
+
+/* Returns the 6-bit block starting at data[start] (with the first bit as the most significant bit).
+ * When 8 bytes are available, the low bit of each of the 6 bytes is kept, and these are gathered into bits 56-61
+ * with a single multiply: bit 0 of byte j is moved to bit 61-j (none of the other partial products overlap these bits,
+ * and there are no carries).
+ */
+static inline unsigned int compressionBlock(const uint8_t *data, long start, long len){
+	unsigned int block = 0;
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+	if(start + 8 <= len){
+		uint64_t bytes;
+		memcpy(&bytes, data + start, sizeof(bytes));
+		bytes &= 0x0000010101010101ULL;
+		return (unsigned int)((bytes * 0x2010080402010000ULL) >> 56) & 0x3F;
+	}
+#endif
+
+	for(int j = 0; j < 6; j++) block |= (data[start + j] & 0x1) << (6-j-1);
+	return block;
+}
+
+double com_exp(double p, unsigned int alph_size, int d, long num_blocks, const vector<long double> &log2Table){
 	double q = (1.0-p)/((double)alph_size-1.0);
-        return G(p, d, num_blocks) + ((double)alph_size-1.0) * G(q, d, num_blocks);
+        return G(p, d, num_blocks, log2Table) + ((double)alph_size-1.0) * G(q, d, num_blocks, log2Table);
 }
 
 // Section 6.3.4 - Compression Estimate
@@ -99,30 +139,37 @@ double compression_test(uint8_t* data, long len, const int verbose, const char *
 	double sigma=0.0, sigma_comp=0.0;
 	double p, entEst;
 	double ldomain, hdomain, lbound, hbound, lvalue, hvalue, pVal, lastP;
+	double log2Dist[COMPRESSION_LOG2_TABLE_SIZE];
+	vector<long double> log2Table;
 
 	d = 1000;
 	num_blocks = len/b;
+	assert(b == 6); //compressionBlock extracts 6-bit blocks
 
 	if(num_blocks <= d){
 		printf("\t*** Warning: not enough samples to run compression test (need more than %d) ***\n", d);
 		return -1.0;
 	}
 
+	//Most of the distances are short, so their log2 values are looked up (the values are the same as calling log2)
+	for(i = 0; i < COMPRESSION_LOG2_TABLE_SIZE; i++) log2Dist[i] = log2((double)i);
+
 	// create dictionary
 	for(i = 0; i < alph_size; i++) dict[i] = 0;
 	for(i = 0; i < d; i++){
-		block = 0;
-		for(j = 0; j < b; j++) block |= (data[i*b + j] & 0x1) << (b-j-1);
+		block = compressionBlock(data, i*b, len);
 		dict[block] = i+1;
 	}
 
 	// test data against dictionary
 	v = num_blocks - d;
 	for(i = d; i < num_blocks; i++){
-		block = 0;
-		for(j = 0; j < b; j++) block |= (data[i*b + j] & 0x1) << (b-j-1);
-		kahan_add(X, X_comp, log2(i+1-dict[block]));
-		kahan_add(sigma, sigma_comp, log2(i+1-dict[block])*log2(i+1-dict[block]));
+		block = compressionBlock(data, i*b, len);
+		const long dist = i+1-dict[block];
+		const double log2d = (dist < COMPRESSION_LOG2_TABLE_SIZE) ? log2Dist[dist] : log2((double)dist);
+
+		kahan_add(X, X_comp, log2d);
+		kahan_add(sigma, sigma_comp, log2d*log2d);
 		dict[block] = i+1;
 	}
 
@@ -143,7 +190,9 @@ double compression_test(uint8_t* data, long len, const int verbose, const char *
 
 	if(verbose == 3) printf("%s Compression Estimate: X-bar' = %.17g\n", label, X);
 
-	if(com_exp(1.0/(double)alph_size, alph_size, d, num_blocks) > X) {
+	initG(log2Table, num_blocks);
+
+	if(com_exp(1.0/(double)alph_size, alph_size, d, num_blocks, log2Table) > X) {
 		ldomain = 1.0 / (double)alph_size;
 		hdomain = 1.0;
 
@@ -156,7 +205,7 @@ double compression_test(uint8_t* data, long len, const int verbose, const char *
 		//Note that the bounds are in [0,1], so overflows aren't an issue
 		//But underflows are.
 		p = (lbound + hbound) / 2.0;
-		pVal = com_exp(p, alph_size, d, num_blocks);
+		pVal = com_exp(p, alph_size, d, num_blocks, log2Table);
 
 		//We don't need the initial pVal invariant, as our initial bounds are infinite.
 		//We don't need the initial bounds, as they are set to the domain bounds
@@ -213,7 +262,7 @@ double compression_test(uint8_t* data, long len, const int verbose, const char *
 			}
 	#pragma GCC diagnostic pop
 
-			pVal = com_exp(p, alph_size, d, num_blocks);
+			pVal = com_exp(p, alph_size, d, num_blocks, log2Table);
 
 			//invariant: If this isn't true, then this isn't loosely monotonic
 			if(!INCLOSEDINTERVAL(pVal, lvalue, hvalue)) {
@@ -19,6 +19,95 @@ struct lagBuf {
 	long buf[D_LAG];
 };
 
+/* Binary Lag prediction estimate.
+ * The last 128 bits are held in two 64-bit words, with S[i-j-1] in bit j, so a single XNOR with
+ * the current bit marks every lag that predicted correctly. The matching lanes are then incremented
+ * together, and the winner is updated in the same way as in the general version below: the counters
+ * are visited from the smallest offset to the largest and a counter wins if it is at least the high score,
+ * so the new winner is the largest updated offset that reaches the (new) maximum score.
+ * count_t must be able to hold L.
+ */
+template <typename count_t>
+static double binaryLagPredictionEstimate(const uint8_t *S, long L, const int verbose, const char *label)
+{
+	count_t scoreboard[D_LAG] = {0};
+	count_t updated[D_LAG];
+	uint8_t lanes[D_LAG];
+	uint8_t laneTable[256][8];
+	uint64_t history[2] = {0, 0};
+	long winner = 0;
+	long curRunOfCorrects = 0;
+	long maxRunOfCorrects = 0;
+	long correctCount = 0;
+	count_t highScore = 0;
+
+	assert(S != NULL);
+	assert(L > 2);
+
+	//laneTable[b] is the byte b expanded to one (0 or 1) byte per bit.
+	for (int b = 0; b < 256; b++) {
+		for (int t = 0; t < 8; t++) laneTable[b][t] = (uint8_t)((b >> t) & 1);
+	}
+
+	// Account for the very first symbol (there isn't a guess for this one)
+	history[0] = S[0] & 1;
+
+	// The rest of the values yield a prediction
+	for (long i = 1; i < L; i++) {
+		const uint64_t curBit = S[i] & 1;
+		const uint64_t fill = 0 - curBit;
+		uint64_t matches[2];
+		count_t roundMax = 0;
+
+		assert(S[i] <= 1);
+
+		// Check the prediction first
+		if (((history[winner >> 6] >> (winner & 63)) & 1) == curBit) {
+			correctCount++;
+			curRunOfCorrects++;
+			if (curRunOfCorrects > maxRunOfCorrects) {
+				maxRunOfCorrects = curRunOfCorrects;
+			}
+		} else {
+			curRunOfCorrects = 0;
+		}
+
+		// Find the lags that would have been correct. Only the first i lags refer to prior symbols.
+		matches[0] = ~(history[0] ^ fill);
+		matches[1] = ~(history[1] ^ fill);
+		if (i < 64) {
+			matches[0] &= (1ULL << i) - 1;
+			matches[1] = 0;
+		} else if (i < (long)D_LAG) {
+			matches[1] &= (1ULL << (i - 64)) - 1;
+		}
+
+		if ((matches[0] | matches[1]) != 0) {
+			// Update counters
+			for (int b = 0; b < 16; b++) memcpy(lanes + 8*b, laneTable[(matches[b >> 3] >> (8*(b & 7))) & 0xFF], 8);
+
+			for (unsigned int j = 0; j < D_LAG; j++) {
+				scoreboard[j] += lanes[j];
+				updated[j] = scoreboard[j] * lanes[j];
+				roundMax = (updated[j] > roundMax) ? updated[j] : roundMax;
+			}
+
+			if (roundMax >= highScore) {
+				long j = D_LAG - 1;
+				while (updated[j] != roundMax) j--;
+				winner = j;
+				highScore = roundMax;
+			}
+		}
+
+		// Add the new symbol
+		history[1] = (history[1] << 1) | (history[0] >> 63);
+		history[0] = (history[0] << 1) | curBit;
+	}
+
+	return predictionEstimate(correctCount, L-1, maxRunOfCorrects, 2, "Lag", verbose, label);
+}
+
 /* Lag prediction estimate (6.3.8)
  * This is a somewhat counter-intuitive approach to this test; the original idea for this approach is due
  * to David Oksner. The straight forward way is simply to check j symbols back for each case (where j runs
@@ -41,6 +130,12 @@ double lag_test(uint8_t *S, long L, int k, const int verbose, const char *label)
 	assert(L > 2);
 	assert(k >= 2);
 
+	if (k == 2) {
+		//No count can exceed L, so 32-bit counters (which double the number of lanes per vector) suffice for all but enormous inputs.
+		if (L < (long)UINT32_MAX) return binaryLagPredictionEstimate<uint32_t>(S, L, verbose, label);
+		else return binaryLagPredictionEstimate<uint64_t>(S, L, verbose, label);
+	}
+
 	ringBuffers = new lagBuf[k];
 
 	//Flag all the rings as empty
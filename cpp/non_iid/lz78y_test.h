@@ -3,31 +3,57 @@
 
 #define B_len 16
 #define MAX_DICTIONARY_SIZE 65536
+//The number of predictions handled at a time once the dictionary is full (see LZ78YCombineChunk)
+#define LZ78Y_CHUNK 16384
+
+/* Once the dictionary is full, no further prefixes are added, so the dictionaries for the different prefix lengths
+ * no longer interact. Each length can then be run separately (in parallel) over a chunk of the data, recording the
+ * count and symbol it would predict (a count of 0 means that the prefix wasn't found). This combines these streams
+ * for the n predictions starting with data[start]: the prediction with the largest count wins, with ties going to the
+ * longest prefix.
+ */
+static void LZ78YCombineChunk(const vector<long> *counts, const vector<uint8_t> *predictions, const uint8_t *data, long start, long n, long &C, long &run_len, long &max_run_len){
+	for(long t = 0; t < n; t++){
+		bool have_prediction = false;
+		uint8_t prediction = 0;
+		long max_count = 0;
 
-static double binaryLZ78YPredictionEstimate(const uint8_t *S, long L, const int verbose, const char *label)
+		for(int j = B_len; j > 0; j--){
+			if(counts[j-1][t] > max_count){
+				max_count = counts[j-1][t];
+				prediction = predictions[j-1][t];
+				have_prediction = true;
+			}
+		}
+
+		// test	prediction of maximum (x,y) pair
+		if(have_prediction && (prediction == data[start+t])){
+			C++;
+			if(++run_len > max_run_len) max_run_len = run_len;
+		}
+		else run_len = 0;
+	}
+}
+
+//The counters for all the prefix lengths are in a single table (see BINARYDICTLOC). count_t must be able to hold L.
+template <typename count_t>
+static double binaryLZ78YPredictionEstimateCounts(const uint8_t *S, long L, const int verbose, const char *label)
 {
-   long *binaryDict[B_len];
+   vector<count_t> binaryDictTable(BINARYDICTSIZE(B_len), 0);
+   count_t *binaryDict = binaryDictTable.data();
    long curRunOfCorrects=0;
    long maxRunOfCorrects=0;
    long correctCount=0;
    long i, j;
    uint32_t curPattern=0;
    long dictElems=0;
+   //The lengths are only run separately if there are threads to run them
+   const bool parallelLengths = (omp_get_max_threads() > 1);
 
    assert(L>B_len);
    assert(L-B_len > 2);
    assert(B_len < 32); //B < 32 to make the bit shifts well defined
 
-   //Initialize the data structure tables
-   for(j=0; j< B_len; j++) {
-      //For a length m prefix, we need 2^m sets of length 2 arrays.
-      //Here, j+1 is the length of the prefix, so we need 2^(j+1) prefixes, or 2*2^(j+1) = 2^(j+2) storage total.
-      //Note: 2^(j+2) = 1<<(j+2).
-      binaryDict[j] = new long[1U<<(j+2)];
-
-      memset(binaryDict[j], 0, sizeof(long)*(1U<<(j+2)));
-   }
-
    // initialize B counts with {(S[15]), S[16]}, {(S[14], S[15]), S[16]}, ..., {(S[0]), S[1], ..., S[15]), S[16]},
    for(j=0; j<B_len; j++) {
       curPattern = curPattern | (((uint32_t)(S[B_len - j - 1]&1)) << j);
@@ -37,28 +63,29 @@ static double binaryLZ78YPredictionEstimate(const uint8_t *S, long L, const int
       dictElems++;
    }
 
+   //curPattern holds the bits prior to S[i], with S[i-1] in the least significant bit.
+   //The j-tuple (S[i-j] ... S[i-1]) is then just the low j bits of curPattern.
+   curPattern = (curPattern << 1) | (S[B_len]&1);
+
    //In C, arrays are 0 indexed.
    //i is the index of the bit to be predicted.
-   for(i=B_len+1; i<L; i++) {
+   for(i=B_len+1; (i<L) && !(parallelLengths && (dictElems >= MAX_DICTIONARY_SIZE)); i++) {
       bool found_x;
       bool havePrediction = false;
       uint8_t roundPrediction=2;
       uint8_t curPrediction=2;
       long maxCount = 0;
+      uint32_t nextPattern = (curPattern << 1) | (S[i]&1);
 
-      //But the first B bits into curPattern
-      curPattern = compressedBitSymbols(S+i-B_len, B_len);
+      //The long prefixes are scattered through a large table, so fetch the entries for the next round now.
+      for(j=BINARYDICTPREFETCH; j<=B_len; j++) __builtin_prefetch(BINARYDICTLOC(j, nextPattern));
 
       //j is the length of the prefix to be used
       for(j=B_len; j>0; j--) {
          long curCount;
-         long *binaryDictEntry;
+         count_t *binaryDictEntry;
 
-         //curPattern starts off as long as possible. We then clear bits at the end
-         //as we shorten curPattern
-         curPattern = curPattern & ((1U<<j)-1);
          //curPattern should contain the j-tuple (S[i-j] ... S[i-1])
-
          binaryDictEntry = BINARYDICTLOC(j, curPattern);
 
           //check if x has been previously seen.
@@ -102,25 +129,83 @@ static double binaryLZ78YPredictionEstimate(const uint8_t *S, long L, const int
       } else {
             curRunOfCorrects = 0;
       }
+
+      curPattern = nextPattern;
    }
 
-   for(j=0; j<B_len; j++) {
-      delete[](binaryDict[j]);
-      binaryDict[j] = NULL;
+   //The dictionary is now full, so handle the remaining predictions a chunk at a time (see LZ78YCombineChunk)
+   if(i < L) {
+      vector<long> counts[B_len];
+      vector<uint8_t> predictions[B_len];
+
+      for(j=0; j<B_len; j++) {
+         counts[j].resize(LZ78Y_CHUNK);
+         predictions[j].resize(LZ78Y_CHUNK);
+      }
+
+      for(long start=i; start<L; start+=LZ78Y_CHUNK) {
+         const long n = (L-start > LZ78Y_CHUNK) ? LZ78Y_CHUNK : (L-start);
+
+         //j is the length of the prefix to be used
+         #pragma omp parallel for schedule(dynamic)
+         for(j=B_len; j>0; j--) {
+            long *lengthCounts = counts[j-1].data();
+            uint8_t *lengthPredictions = predictions[j-1].data();
+            uint32_t pattern = 0;
+
+            //pattern should contain the j-tuple (S[i-j] ... S[i-1])
+            for(long k=start-j; k<start; k++) pattern = (pattern << 1) | (S[k]&1);
+
+            for(long t=0; t<n; t++) {
+               const uint8_t curSymbol = S[start+t]&1;
+               count_t *binaryDictEntry = BINARYDICTLOC(j, pattern);
+
+               if(j >= BINARYDICTPREFETCH) __builtin_prefetch(BINARYDICTLOC(j, (pattern << 1) | curSymbol));
+
+               //For the prediction, take the max across all pairs (there are only 2 symbols here!)
+               if((binaryDictEntry[0] > binaryDictEntry[1])) {
+                  lengthPredictions[t] = 0;
+                  lengthCounts[t] = binaryDictEntry[0];
+               } else {
+                  lengthPredictions[t] = 1;
+                  lengthCounts[t] = binaryDictEntry[1];
+               }
+
+               // If x is present in the dictionary as a prefix, count (x,y).
+               // Otherwise, there's no room to add it.
+               if(lengthCounts[t] != 0) binaryDictEntry[curSymbol]++;
+
+               pattern = (pattern << 1) | curSymbol;
+            }
+         }
+
+         LZ78YCombineChunk(counts, predictions, S, start, n, correctCount, curRunOfCorrects, maxRunOfCorrects);
+      }
    }
 
    return(predictionEstimate(correctCount, L-B_len-1, maxRunOfCorrects, 2, "LZ78Y", verbose, label));
 }
 
+static double binaryLZ78YPredictionEstimate(const uint8_t *S, long L, const int verbose, const char *label)
+{
+   //No count can exceed L, so 32-bit counters (which halve the table size) are safe for all but enormous inputs.
+   if(L < (long)UINT32_MAX) return binaryLZ78YPredictionEstimateCounts<uint32_t>(S, L, verbose, label);
+   else return binaryLZ78YPredictionEstimateCounts<uint64_t>(S, L, verbose, label);
+}
+
 // Section 6.3.10 - LZ78Y Prediction Estimate
 double LZ78Y_test(uint8_t *data, long len, int alph_size, const int verbose, const char *label) {
 	int dict_size;
 	long i, j, N, C, run_len, max_run_len;
-	array<uint8_t, B_len> x;
+	uint128_t window;
+	uint128_t x;
+	//The lengths are only run separately if there are threads to run them
+	const bool parallelLengths = (omp_get_max_threads() > 1);
 
 	if(alph_size==2) return binaryLZ78YPredictionEstimate(data, len, verbose, label);
 
-	array<map<array<uint8_t, B_len>, PostfixDictionary>, B_len> D;
+	//D[j-1] is the dictionary for the length j contexts
+	array<ContextDictionary, B_len> D;
 
 	if(len < B_len+2){	
 		printf("\t*** Warning: not enough samples to run LZ78Y test (need more than %d) ***\n", B_len+2);
@@ -134,32 +219,34 @@ double LZ78Y_test(uint8_t *data, long len, int alph_size, const int verbose, con
 
 	// initialize dictionary counts
 	dict_size = 0;
-	memset(x.data(), 0, B_len);
 	// initialize LZ78Y counts with {(S[15]), S[16]}, {(S[14], S[15]), S[16]}, ..., {(S[0]), S[1], ..., S[15]), S[16]}
+	window = contextWindow(data+B_len, B_len);
 	for(j = 1; j <= B_len; j++){
-		memcpy(x.data(), data+B_len-j, j);
-		D[j-1][x].incrementPostfix(data[B_len], true);
+		x = window & contextMask(j);
+		D[j-1].incrementPostfix(D[j-1].findOrCreate(x), data[B_len], true);
 		dict_size++;
 	}
 
 	// perform predictions
-	for(i = B_len+1; i < len; i++) {
+	//window holds the B_len symbols prior to S[i]. The prefix string for length j, (S[i-j] ... S[i-1]), is the low j bytes,
+	//so each round's contexts come from the prior round's window with a single shift.
+	window = (window << 8) | data[B_len];
+	for(i = B_len+1; (i < len) && !(parallelLengths && (dict_size >= MAX_DICTIONARY_SIZE)); i++) {
 		bool found_x;
 		bool have_prediction = false;
 		uint8_t prediction = 0;
 		long max_count = 0;
 
 		for(j = B_len; j > 0; j--) {
-			map<array<uint8_t, B_len>, PostfixDictionary>::iterator curp;
+			long curp;
 
 			// check if x has been previously seen. 
 			//For the prediction, roundPrediction is the max across all pairs
 			//The prefix string should contain the j-tuple (S[i-j] ... S[i-1])
-			memset(x.data(), 0, B_len);
-			memcpy(x.data(), data+i-j, j);
+			x = window & contextMask(j);
 			curp = D[j-1].find(x);
 
-			if(curp == D[j-1].end()) found_x = false;
+			if(curp < 0) found_x = false;
 			else found_x = true;
 
 			if(found_x) {
@@ -168,7 +255,7 @@ double LZ78Y_test(uint8_t *data, long len, int alph_size, const int verbose, con
 
 				// x has occurred, find max (x,y) pair across all y's
 				// Check to see if the current prediction is correct.
-				y = (curp->second).predict(count);
+				y = D[j-1].predict(curp, count);
 
 				if(count > max_count){
 					max_count = count;
@@ -176,12 +263,12 @@ double LZ78Y_test(uint8_t *data, long len, int alph_size, const int verbose, con
 					have_prediction = true;
 				}
 				//x exists as a prefix, so we always increment (and perhaps add a new postfix)
-				(curp->second).incrementPostfix(data[i], true);
+				D[j-1].incrementPostfix(curp, data[i], true);
 			} else if(dict_size < MAX_DICTIONARY_SIZE) {
 				//We didn't find the x prefix, so (x,y) surely can't have occurred.
                                 //We're allowed to make a new entry. Do so.
                                 //curp isn't populated here, because it wasn't found
-				D[j-1][x].incrementPostfix(data[i], true);
+				D[j-1].incrementPostfix(D[j-1].findOrCreate(x), data[i], true);
 				dict_size++;
 			}
 		}
@@ -192,6 +279,50 @@ double LZ78Y_test(uint8_t *data, long len, int alph_size, const int verbose, con
 			if(++run_len > max_run_len) max_run_len = run_len;
 		}
 		else run_len = 0;
+
+		window = (window << 8) | data[i];
+	}
+
+	//The dictionary is now full, so handle the remaining predictions a chunk at a time (see LZ78YCombineChunk)
+	if(i < len) {
+		vector<long> counts[B_len];
+		vector<uint8_t> predictions[B_len];
+
+		for(j = 0; j < B_len; j++){
+			counts[j].resize(LZ78Y_CHUNK);
+			predictions[j].resize(LZ78Y_CHUNK);
+		}
+
+		for(long start = i; start < len; start += LZ78Y_CHUNK){
+			const long n = (len-start > LZ78Y_CHUNK) ? LZ78Y_CHUNK : (len-start);
+
+			#pragma omp parallel for schedule(dynamic)
+			for(j = B_len; j > 0; j--) {
+				const uint128_t mask = contextMask(j);
+				long *lengthCounts = counts[j-1].data();
+				uint8_t *lengthPredictions = predictions[j-1].data();
+				//lengthWindow holds (at least) the j symbols prior to S[i]
+				uint128_t lengthWindow = contextWindow(data+start, j);
+
+				for(long t = 0; t < n; t++){
+					const long curp = D[j-1].find(lengthWindow & mask);
+
+					if(curp >= 0) {
+						// x has occurred, find max (x,y) pair across all y's
+						lengthPredictions[t] = D[j-1].predict(curp, lengthCounts[t]);
+						//x exists as a prefix, so we always increment (and perhaps add a new postfix)
+						D[j-1].incrementPostfix(curp, data[start+t], true);
+					} else {
+						//We didn't find the x prefix, and there's no room to add it.
+						lengthCounts[t] = 0;
+					}
+
+					lengthWindow = (lengthWindow << 8) | data[start+t];
+				}
+			}
+
+			LZ78YCombineChunk(counts, predictions, data, start, n, C, run_len, max_run_len);
+		}
 	}
 
 	return(predictionEstimate(C, N, max_run_len, alph_size, "LZ78Y", verbose, label));
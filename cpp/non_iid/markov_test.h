@@ -6,6 +6,7 @@
 double markov_test(uint8_t* data, long len, const int verbose, const char *label){
 	long i, C_0, C_1, C_00, C_10;
 	double H_min, tmp_min_entropy, P_0, P_1, P_00, P_01, P_10, P_11, entEst;
+	vector<uint64_t> packed;
 
 	C_0 = 0;
 	C_00 = 0;
@@ -15,12 +16,17 @@ double markov_test(uint8_t* data, long len, const int verbose, const char *label
 	assert(len > 1);
 
 	// get counts for unconditional and transition probabilities
-	for(i = 0; i < len-1; i++){
-		if(data[i] == 0){
-			C_0++;
-			if(data[i+1] == 0) C_00++;
-		}
-		else if(data[i+1] == 0) C_10++;
+	// The bits are packed into words, so that for each of S[0] ... S[len-2] (the bits with a successor),
+	// the word holding the successors is just the next 64 bits of the string, and the counts are popcounts.
+	packBits(data, len, packed);
+	for(i = 0; i < len-1; i += 64){
+		const uint64_t cur = packed[i >> 6];
+		const uint64_t next = extractBits(packed.data(), i+1);
+		const uint64_t valid = (len-1-i >= 64) ? UINT64_MAX : ((1ULL << (len-1-i)) - 1);
+
+		C_0 += __builtin_popcountll(~cur & valid);
+		C_00 += __builtin_popcountll(~cur & ~next & valid);
+		C_10 += __builtin_popcountll(cur & ~next & valid);
 	}
 
 	//C_0 is now  the number of 0 bits from S[0] to S[len-2]
@@ -3,87 +3,222 @@
 
 #define NUM_WINS 4
 
+/* The symbols in each window are kept in buckets by their count; each bucket is a circular doubly linked list
+ * of the symbols having that count. The most frequent symbol (with ties going to the most recently seen symbol)
+ * then comes from the top one or two buckets, rather than from a scan of the entire alphabet.
+ * Nodes 0 ... alph_size-1 are the symbols, and node alph_size+c is the list head for count c, so that
+ * moving a symbol between lists doesn't need any branches.
+ */
+struct mcwNode {
+	int16_t next;
+	int16_t prev;
+};
+
+static void mcwBucketsInit(vector<mcwNode> &nodes, int maxCount, int alph_size){
+	nodes.resize(alph_size + maxCount + 2);
+
+	//All the symbols start off with count 0
+	for(int c = 0; c <= maxCount+1; c++) nodes[alph_size + c].next = nodes[alph_size + c].prev = (int16_t)(alph_size + c);
+	for(int s = 0; s < alph_size; s++){
+		nodes[s].next = nodes[alph_size].next;
+		nodes[s].prev = (int16_t)alph_size;
+		nodes[nodes[alph_size].next].prev = (int16_t)s;
+		nodes[alph_size].next = (int16_t)s;
+	}
+}
+
+//Move sym from its current list to the list starting at node "head"
+static inline void mcwBucketsMove(mcwNode *nodes, int sym, int head){
+	nodes[nodes[sym].prev].next = nodes[sym].next;
+	nodes[nodes[sym].next].prev = nodes[sym].prev;
+
+	nodes[sym].next = nodes[head].next;
+	nodes[sym].prev = (int16_t)head;
+	nodes[nodes[head].next].prev = (int16_t)sym;
+	nodes[head].next = (int16_t)sym;
+}
+
+/* The state of a single window: the symbol counts, the last position of each symbol, the count buckets
+ * and the current most common symbol.
+ */
+struct mcwWindow {
+	int W;
+	long max_cnt;
+	uint8_t frequent;
+	vector<long> cnts;
+	vector<long> poses;
+	vector<mcwNode> nodes;
+};
+
+//Set up the window with the first W symbols.
+static void mcwWindowInit(mcwWindow &win, const uint8_t *data, int W, int alph_size){
+	win.W = W;
+	win.max_cnt = 0;
+	win.frequent = 0;
+	win.cnts.assign(alph_size, 0);
+	win.poses.assign(alph_size, 0);
+	mcwBucketsInit(win.nodes, W, alph_size);
+
+	for(long i = 0; i < W; i++){
+		if(win.max_cnt <= ++win.cnts[data[i]]){
+			win.max_cnt = win.cnts[data[i]];
+			win.frequent = data[i];
+		}
+		mcwBucketsMove(win.nodes.data(), data[i], alph_size + win.cnts[data[i]]);
+		win.poses[data[i]] = i;
+	}
+}
+
+//Slide the window forward to include data[i] (and drop data[i-W]), and select the new frequent.
+static inline void mcwWindowAdvance(mcwWindow &win, const uint8_t *data, long i, int alph_size){
+	const uint8_t outgoing = data[i-win.W];
+	const uint8_t incoming = data[i];
+	mcwNode *nodes = win.nodes.data();
+	long *cnts = win.cnts.data();
+
+	if(outgoing != incoming){
+		cnts[outgoing]--;
+		mcwBucketsMove(nodes, outgoing, alph_size + cnts[outgoing]);
+		cnts[incoming]++;
+		mcwBucketsMove(nodes, incoming, alph_size + cnts[incoming]);
+	}
+	win.poses[incoming] = i;
+
+	if((outgoing != win.frequent) && (win.max_cnt <= cnts[incoming])){
+		win.max_cnt = cnts[incoming];
+		win.frequent = incoming;
+	}
+	else if(outgoing == win.frequent){
+		// search for the new frequent. The old frequent now has a count of at least max_cnt-1,
+		// and the incoming symbol may have gained a count of max_cnt+1, so the top count is one of these three.
+		if(nodes[alph_size + win.max_cnt + 1].next < alph_size) win.max_cnt++;
+		else if(nodes[alph_size + win.max_cnt].next >= alph_size) win.max_cnt--;
+		assert(nodes[alph_size + win.max_cnt].next < alph_size);
+
+		if(cnts[incoming] == win.max_cnt){
+			// The incoming symbol is the most recent, so it wins any tie
+			win.frequent = incoming;
+		} else {
+			// Otherwise, the most recently seen symbol with the top count wins
+			long max_pos = -1;
+			for(int k = nodes[alph_size + win.max_cnt].next; k < alph_size; k = nodes[k].next){
+				if(max_pos < win.poses[k]){
+					win.frequent = k;
+					max_pos = win.poses[k];
+				}
+			}
+		}
+	}
+}
+
+/* For bitstrings, all the window lengths are odd, so the most common bit in a window is just the majority bit.
+ * The string is packed into 64-bit words, and the number of ones in each window is tracked for blocks of 64
+ * predictions using popcounts, which yields a mask of the correct predictions for each window.
+ * The scoreboard is then replayed for the block (see replayScoreboard).
+ */
+static double binaryMultiMCWPredictionEstimate(const uint8_t *S, long L, const int W[NUM_WINS], const int verbose, const char *label){
+	vector<uint64_t> packed;
+	predictorScoreboard sb;
+	long ones[NUM_WINS] = {0}; // The number of ones in S[b-W[j]] ... S[b-1]
+	uint8_t prefixOnes[65];
+
+	for(int j = 0; j < NUM_WINS; j++) assert((W[j] & 1) == 1);
+	for(int j = 1; j < NUM_WINS; j++) assert(W[j-1] < W[j]);
+
+	packBits(S, L, packed);
+	initPredictorScoreboard(sb, NUM_WINS);
+
+	for(long b = 0; b < L; b += 64){
+		const uint64_t cur = packed[b >> 6];
+		uint64_t predicted[NUM_WINS], correct[NUM_WINS];
+		// Predictions are made for S[W[0]] ... S[L-1]
+		const int lo = (b >= W[0]) ? 0 : (int)(W[0] - b);
+		const int hi = (L - b >= 64) ? 64 : (int)(L - b);
+
+		prefixOnes[0] = 0;
+		for(int t = 0; t < 64; t++) prefixOnes[t+1] = prefixOnes[t] + (uint8_t)((cur >> t) & 1);
+
+		for(int j = 0; j < NUM_WINS; j++){
+			const uint64_t lag = extractBits(packed.data(), b - W[j]);
+			uint64_t mask = 0;
+			uint64_t active = UINT64_MAX;
+
+			for(int t = 0; t < 64; t++){
+				// The number of ones in S[b+t-W[j]] ... S[b+t-1]
+				const long count = ones[j] + prefixOnes[t] - __builtin_popcountll(lag & ((1ULL << t) - 1));
+				const uint64_t majority = (2*count > W[j]) ? 1 : 0;
+				mask |= (~(majority ^ (cur >> t)) & 1) << t;
+			}
+
+			// Only windows that are full make predictions, and only for the samples that exist
+			if(b + 64 <= W[j]) active = 0;
+			else if(b < W[j]) active = UINT64_MAX << (W[j] - b);
+			if(hi < 64) active &= (1ULL << hi) - 1;
+
+			predicted[j] = active >> lo;
+			correct[j] = (mask & active) >> lo;
+			ones[j] += prefixOnes[64] - __builtin_popcountll(lag);
+		}
+
+		if(lo < hi) replayScoreboard(sb, predicted, correct, hi - lo);
+	}
+
+	return(predictionEstimate(sb.C, L-W[0], sb.max_run_len, 2, "MultiMCW", verbose, label));
+}
+
 // Section 6.3.7 - Multi Most Common in Window (MCW) Prediction Estimate
+/* The windows are independent until the scoreboard is consulted, so the windows are advanced (in parallel) over
+ * a chunk of the data, recording which predictions were correct, and then the scoreboard is replayed for the chunk.
+ */
 double multi_mcw_test(uint8_t *data, long len, int alph_size, const int verbose, const char *label){
-	int winner;
 	int W[NUM_WINS] = {63, 255, 1023, 4095};
-	long i, j, k, N, C, run_len, max_run_len, max_pos; 
-	long scoreboard[NUM_WINS] = {0};
-	long max_cnts[NUM_WINS] = {0};
-	long win_cnts[NUM_WINS][alph_size], win_poses[NUM_WINS][alph_size]; 
-	uint8_t frequent[NUM_WINS];
-	
-	if(len < W[NUM_WINS-1]+1){	
+	long N;
+	mcwWindow windows[NUM_WINS];
+	predictorScoreboard sb;
+	vector<uint64_t> predicted[NUM_WINS], correct[NUM_WINS];
+
+	if(len < W[NUM_WINS-1]+1){
 		printf("\t*** Warning: not enough samples to run multiMCW test (need more than %d) ***\n", W[NUM_WINS-1]+1);
 		return -1.0;
 	}
 
+	if(alph_size == 2) return binaryMultiMCWPredictionEstimate(data, len, W, verbose, label);
+
 	N = len-W[0];
-	winner = 0;
-	C = 0;
-	run_len = 0;
-	max_run_len = 0;
-	for(i = 0; i < NUM_WINS; i++){
-		for(j = 0; j < alph_size; j++){
-			win_cnts[i][j] = 0;
-			win_poses[i][j] = 0;
-		}
-	}
+	initPredictorScoreboard(sb, NUM_WINS);
 
 	// compute initial window counts
-	for(i = 0; i < W[NUM_WINS-1]; i++){
-		for(j = 0; j < NUM_WINS; j++){
-			if(i < W[j]){
-				if(max_cnts[j] <= ++win_cnts[j][data[i]]){
-					max_cnts[j] = win_cnts[j][data[i]];
-					frequent[j] = data[i];
-				}
-				win_poses[j][data[i]] = i;
-			}
-		}
+	for(int j = 0; j < NUM_WINS; j++){
+		mcwWindowInit(windows[j], data, W[j], alph_size);
+		predicted[j].resize(PREDICTOR_CHUNK / 64);
+		correct[j].resize(PREDICTOR_CHUNK / 64);
 	}
 
 	// perform predictions
-	for (i = W[0]; i < len; i++){
-		// test prediction of winner
-		if(frequent[winner] == data[i]){
-			C++;
-			if(++run_len > max_run_len) max_run_len = run_len;
-		}
-		else run_len = 0;
+	for(long start = W[0]; start < len; start += PREDICTOR_CHUNK){
+		const long end = (len - start > PREDICTOR_CHUNK) ? (start + PREDICTOR_CHUNK) : len;
 
-		// update scoreboard and select new winner
-		for(j = 0; j < NUM_WINS; j++){
-			if((i >= W[j]) && (frequent[j] == data[i])){
-				if(++scoreboard[j] >= scoreboard[winner]) winner = j;
-			}
-		}
-	
-		// update window counts and select new frequents
-		for(j = 0; j < NUM_WINS; j++){
-			if(i >= W[j]){
-				win_cnts[j][data[i-W[j]]]--;
-				win_cnts[j][data[i]]++;
-				win_poses[j][data[i]] = i;
-				if((data[i-W[j]] != frequent[j]) && (max_cnts[j] <= win_cnts[j][data[i]])){
-					max_cnts[j] = win_cnts[j][data[i]];
-					frequent[j] = data[i];
-				}
-				else if(data[i-W[j]] == frequent[j]){
-					max_cnts[j]--;
-					// search for possible new frequent
-					max_pos = i-W[j];
-					for(k = 0; k < alph_size; k++){
-						if((max_cnts[j] < win_cnts[j][k]) || ((max_cnts[j] == win_cnts[j][k]) && (max_pos <= win_poses[j][k]))){
-							max_cnts[j] = win_cnts[j][k];
-							frequent[j] = k;
-							max_pos = win_poses[j][k];
-						}
-					}
+		#pragma omp parallel for schedule(dynamic)
+		for(int j = 0; j < NUM_WINS; j++){
+			mcwWindow &win = windows[j];
+
+			for(long b = start; b < end; b += 64){
+				uint64_t predictedMask = 0, correctMask = 0;
+
+				for(long i = (b >= W[j]) ? b : W[j]; (i < b+64) && (i < end); i++){
+					// test prediction of this window, then update the window
+					predictedMask |= 1ULL << (i - b);
+					if(win.frequent == data[i]) correctMask |= 1ULL << (i - b);
+					mcwWindowAdvance(win, data, i, alph_size);
 				}
+
+				predicted[j][(b - start) >> 6] = predictedMask;
+				correct[j][(b - start) >> 6] = correctMask;
 			}
 		}
+
+		replayScoreboardChunk(sb, predicted, correct, end - start);
 	}
 
-	return(predictionEstimate(C, N, max_run_len, alph_size, "MultiMCW", verbose, label));
+	return(predictionEstimate(sb.C, N, sb.max_run_len, alph_size, "MultiMCW", verbose, label));
 }
@@ -4,32 +4,63 @@
 #define D_MMC 16
 #define MAX_ENTRIES 100000
 
-static double binaryMultiMMCPredictionEstimate(const uint8_t *S, long L, const int verbose, const char *label)
+//The results of a single depth's prediction
+#define MMC_NO_PREDICTION 0
+#define MMC_INCORRECT 1
+#define MMC_CORRECT 2
+
+//Predict curSymbol using the depth d dictionary entry binaryDictEntry, and then update the entry.
+//If lookup is false, the prefix is already known to be absent.
+template <typename count_t>
+static inline int binaryMMCStep(count_t *binaryDictEntry, long &dictElems, uint8_t curSymbol, bool lookup)
 {
+   // check if the prefix x has been previously seen. If the prefix x has not occurred,
+   // then do not make a prediction.
+   if(lookup && ((binaryDictEntry[0] != 0) || (binaryDictEntry[1] != 0))) {
+      //For the prediction, take the max across all pairs (there are only 2 symbols here!)
+      const uint8_t curPrediction = (binaryDictEntry[0] > binaryDictEntry[1]) ? 0 : 1;
+
+      //Now check to see in (x,y) needs to be counted or (x,y) added to the dictionary
+      if(binaryDictEntry[curSymbol] != 0) {
+         //The (x,y) tuple has already been encountered.
+         //Increment the existing entry
+         binaryDictEntry[curSymbol]++;
+      } else if(dictElems < MAX_ENTRIES) {
+         //The x prefix has been encountered, but not (x,y)
+         //We're allowed to make a new entry. Do so.
+         binaryDictEntry[curSymbol]=1;
+         dictElems++;
+      }
+
+      return (curPrediction == curSymbol) ? MMC_CORRECT : MMC_INCORRECT;
+   } else if(dictElems < MAX_ENTRIES) {
+      //We didn't find the x prefix, so (x,y) surely can't have occurred.
+      //We're allowed to make a new entry. Do so.
+      binaryDictEntry[curSymbol]=1;
+      dictElems++;
+   }
+
+   return MMC_NO_PREDICTION;
+}
 
-   long scoreboard[D_MMC] = {0};
-   long *binaryDict[D_MMC];
-   long winner = 0;
-   long curWinner;
-   long curRunOfCorrects = 0;
-   long maxRunOfCorrects = 0;
-   long correctCount = 0;
-   long j, d, i;
+//The counters for all the prefix lengths are in a single table (see BINARYDICTLOC). count_t must be able to hold L.
+//As in the non-binary version, the depths may be run in parallel over a chunk of the data, with the scoreboard replayed afterward.
+template <typename count_t>
+static double binaryMultiMMCPredictionEstimateCounts(const uint8_t *S, long L, const int verbose, const char *label)
+{
+   vector<count_t> binaryDictTable(BINARYDICTSIZE(D_MMC), 0);
+   count_t *binaryDict = binaryDictTable.data();
+   predictorScoreboard sb;
+   vector<uint64_t> predicted[D_MMC], correct[D_MMC];
+   //The depths are only run separately if there are threads to run them
+   const bool parallelDepths = (omp_get_max_threads() > 1);
+   long d;
    uint32_t curPattern=0;
    long dictElems[D_MMC] = {0};
 
    assert(L>3);
    assert(D_MMC < 31); //D+1 < 32 to make the bit shifts well defined
 
-   //Initialize the predictors
-   for(j=0; j< D_MMC; j++) {
-      //For a length m prefix, we need 2^m sets of length 2 arrays.
-      //Here, j+1 is the length of the prefix, so we need 2^(j+1) prefixes, or 2*2^(j+1) = 2^(j+2) storage total.
-      //Note: 2^(j+2) = 1<<(j+2).
-      binaryDict[j] = new long[1U<<(j+2)];
-      memset(binaryDict[j], 0, sizeof(long)*(1U<<(j+2)));
-   }
-
    // initialize MMC counts
    for(d=0; d<D_MMC; d++) {
       curPattern = ((curPattern << 1) | (S[d]&1));
@@ -37,95 +68,129 @@ static double binaryMultiMMCPredictionEstimate(const uint8_t *S, long L, const i
       //This is necessarily the first symbol of this length
       (BINARYDICTLOC(d+1, curPattern))[S[d+1]&1] = 1;
       dictElems[d] = 1;
+      predicted[d].resize(PREDICTOR_CHUNK/64);
+      correct[d].resize(PREDICTOR_CHUNK/64);
    }
 
-   
+   initPredictorScoreboard(sb, D_MMC);
+
+   //curPattern holds the bits prior to S[i], with S[i-1] in the least significant bit.
+   //The (d+1)-tuple (S[i-d-1] ... S[i-1]) is then just the low d+1 bits of curPattern.
+   curPattern = ((uint32_t)(S[0]&1) << 1) | (S[1]&1);
+
    //In C, arrays are 0 indexed.
    //i is the index of the new symbol to be predicted
-   for(i=2; i<L; i++) {
-      bool found_x = false;
-
-      curWinner = winner;
-      curPattern = 0;
-
-      //d+1 is the number of symbols used by the predictor
-      for(d=0; (d<D_MMC) && (d<=i-2); d++) {
-         uint8_t curPrediction = 2;
-         long curCount;
-         long *binaryDictEntry;
-
-         //Add S[i-d-1] to the start of curPattern
-         curPattern = (curPattern | (((uint32_t)(S[i-d-1]&1))<<d));
-         //curPattern should contain the d-tuple (S[i-d-1] ... S[i-1])
-
-         binaryDictEntry = BINARYDICTLOC(d+1, curPattern);
-
-         // check if the prefix x has been previously seen. If the prefix x has not occurred,
-         // then do not make a prediction for current d and larger d's
-         // as well, since it will not occur for them either. In other words,
-         // prediction is NULL, so do not update the scoreboard.
-         // Note that found_x is meaningless on the first round, but for that round d==0.
-         // All future rounds use a meaningful found_x
-         if((d == 0) || found_x) {
-            //For the prediction, curPrediction is the max across all pairs (there are only 2 symbols here!)
-            if((binaryDictEntry[0] > binaryDictEntry[1])) {
-               curPrediction = 0;
-               curCount = binaryDictEntry[0];
-            } else {
-               curPrediction = 1;
-               curCount = binaryDictEntry[1];
-            }
+   for(long start=2; start<L; start+=PREDICTOR_CHUNK) {
+      const long end = (L-start > PREDICTOR_CHUNK) ? (start+PREDICTOR_CHUNK) : L;
 
-            if(curCount == 0) found_x = false;
-            else found_x = true;
-         }
+      if(parallelDepths) {
+         //d+1 is the number of symbols used by the predictor
+         #pragma omp parallel for schedule(dynamic)
+         for(d=0; d<D_MMC; d++) {
+            //The first prediction for this depth is for S[d+2]
+            const long first = (start >= d+2) ? start : (d+2);
+            uint32_t pattern = 0;
+
+            for(long i=first-d-1; i<first; i++) pattern = (pattern << 1) | (S[i]&1);
+
+            for(long b=start; b<end; b+=64) {
+               uint64_t predictedMask = 0, correctMask = 0;
 
-         if(found_x) {
-            // x is present as a prefix.
-            // Check to see if the current prediction is correct.
-            if(curPrediction == S[i]) {
-               // prediction is correct, update scoreboard and (the next round's) winner
-               scoreboard[d]++;
-               if(scoreboard[d] >= scoreboard[winner]) winner = d;
-
-               //If the best predictor was previously d, increment the relevant counters
-               if(d == curWinner){
-                  correctCount++;
-                  curRunOfCorrects++;
-                  if(curRunOfCorrects > maxRunOfCorrects) maxRunOfCorrects = curRunOfCorrects;
+               for(long i=(b>=first)?b:first; (i<b+64) && (i<end); i++) {
+                  const uint8_t curSymbol = S[i]&1;
+                  int result;
+
+                  //The long prefixes are scattered through a large table, so fetch the entry for the next round now.
+                  if(d+1 >= BINARYDICTPREFETCH) __builtin_prefetch(BINARYDICTLOC(d+1, (pattern << 1) | curSymbol));
+
+                  result = binaryMMCStep(BINARYDICTLOC(d+1, pattern), dictElems[d], curSymbol, true);
+                  predictedMask |= ((uint64_t)(result != MMC_NO_PREDICTION)) << (i-b);
+                  correctMask |= ((uint64_t)(result == MMC_CORRECT)) << (i-b);
+
+                  pattern = (pattern << 1) | curSymbol;
                }
-            } else if(d == curWinner) {
-               //This prediction was wrong;
-               //If the best predictor was previously d, zero the run length counter
-               curRunOfCorrects = 0;
+
+               predicted[d][(b-start)>>6] = predictedMask;
+               correct[d][(b-start)>>6] = correctMask;
             }
+         }
 
-            //Now check to see in (x,y) needs to be counted or (x,y) added to the dictionary
-            if(binaryDictEntry[S[i]&1] != 0) {
-               //The (x,y) tuple has already been encountered.
-               //Increment the existing entry
-               binaryDictEntry[S[i]&1]++;
-            } else if(dictElems[d] < MAX_ENTRIES) {
-               //The x prefix has been encountered, but not (x,y)
-               //We're allowed to make a new entry. Do so.
-               binaryDictEntry[S[i]&1]=1;
-               dictElems[d]++;
+         replayScoreboardChunk(sb, predicted, correct, end-start);
+      } else {
+         //With a single thread, it's faster to keep the scoreboard as we go, and to only look up the
+         //longer prefixes while the shorter prefixes have been found.
+         for(long i=start; i<end; i++) {
+            const uint8_t curSymbol = S[i]&1;
+            const int curWinner = sb.winner;
+            bool found_x = true;
+
+            //The long prefixes are scattered through a large table, so fetch the entries for the next round now.
+            for(d=BINARYDICTPREFETCH-1; d<D_MMC; d++) __builtin_prefetch(BINARYDICTLOC(d+1, (curPattern << 1) | curSymbol));
+
+            //d+1 is the number of symbols used by the predictor
+            for(d=0; (d<D_MMC) && (d<=i-2); d++) {
+               const int result = binaryMMCStep(BINARYDICTLOC(d+1, curPattern), dictElems[d], curSymbol, found_x);
+
+               found_x = (result != MMC_NO_PREDICTION);
+               if(result == MMC_CORRECT) {
+                  // prediction is correct, update scoreboard and (the next round's) winner
+                  if(++sb.scoreboard[d] >= sb.scoreboard[sb.winner]) sb.winner = d;
+
+                  //If the best predictor was previously d, increment the relevant counters
+                  if(d == curWinner) {
+                     sb.C++;
+                     if(++sb.run_len > sb.max_run_len) sb.max_run_len = sb.run_len;
+                  }
+               } else if((result == MMC_INCORRECT) && (d == curWinner)) {
+                  //This prediction was wrong;
+                  //If the best predictor was previously d, zero the run length counter
+                  sb.run_len = 0;
+               }
             }
-         } else if(dictElems[d] < MAX_ENTRIES) {
-            //We didn't find the x prefix, so (x,y) surely can't have occurred.
-            //We're allowed to make a new entry. Do so.
-            binaryDictEntry[S[i]&1]=1;
-            dictElems[d]++;
+
+            curPattern = (curPattern << 1) | curSymbol;
          }
       }
    }
 
-   for(j=0; j<D_MMC; j++) {
-      delete[](binaryDict[j]);
-      binaryDict[j] = NULL;
-   }
+   return(predictionEstimate(sb.C, L-2, sb.max_run_len, 2, "MultiMMC", verbose, label));
+}
 
-   return(predictionEstimate(correctCount, L-2, maxRunOfCorrects, 2, "MultiMMC", verbose, label));
+static double binaryMultiMMCPredictionEstimate(const uint8_t *S, long L, const int verbose, const char *label)
+{
+   //No count can exceed L, so 32-bit counters (which halve the table size) are safe for all but enormous inputs.
+   if(L < (long)UINT32_MAX) return binaryMultiMMCPredictionEstimateCounts<uint32_t>(S, L, verbose, label);
+   else return binaryMultiMMCPredictionEstimateCounts<uint64_t>(S, L, verbose, label);
+}
+
+//Predict "symbol" using the dictionary M for the context "context", and then update the dictionary.
+//If lookup is false, the context is already known to be absent.
+static inline int MMCStep(ContextDictionary &M, int &entries, uint128_t context, uint8_t symbol, bool lookup){
+	// check if x has been previously seen as a prefix. If the prefix x has not occurred,
+	// then the prediction is NULL, so do not update the scoreboard.
+	const long curp = lookup ? M.find(context) : -1;
+
+	if(curp >= 0){
+		long predictCount;
+		// x has occurred, find max (x,y) pair across all y's
+		// Check to see if the current prediction is correct.
+		const int result = (M.predict(curp, predictCount) == symbol) ? MMC_CORRECT : MMC_INCORRECT;
+
+		//Now check to see in (x,y) needs to be counted or (x,y) added to the dictionary
+		if(M.incrementPostfix(curp, symbol, entries < MAX_ENTRIES)) {
+			//We had to make a new entry. Count this.
+			entries++;
+		}
+
+		return result;
+	} else if(entries < MAX_ENTRIES) {
+		//We didn't find the x prefix, so (x,y) surely can't have occurred.
+		//We're allowed to make a new entry. Do so.
+		M.incrementPostfix(M.findOrCreate(context), symbol, true);
+		entries++;
+	}
+
+	return MMC_NO_PREDICTION;
 }
 
 // Section 6.3.9 - MultiMMC Prediction Estimate
@@ -145,15 +210,19 @@ static double binaryMultiMMCPredictionEstimate(const uint8_t *S, long L, const i
  *    we should have), this can't happen in practice because we add strings from shortest to longest.
  */
 double multi_mmc_test(uint8_t *data, long len, int alph_size, const int verbose, const char *label){
-	int winner, cur_winner;
 	int entries[D_MMC];
-	long i, d, N, C, run_len, max_run_len;
-	long scoreboard[D_MMC] = {0};
-	array<uint8_t, D_MMC> x;
+	long d, N;
+	predictorScoreboard sb;
+	vector<uint64_t> predicted[D_MMC], correct[D_MMC];
+	//The depths are only run separately if there are threads to run them
+	const bool parallelDepths = (omp_get_max_threads() > 1);
+	uint128_t window;
+	uint128_t x;
 
 	if(alph_size == 2) return binaryMultiMMCPredictionEstimate(data, len, verbose, label);
 
-	array<map<array<uint8_t, D_MMC>, PostfixDictionary>, D_MMC> M;
+	//M[d] is the dictionary for the length d+1 contexts
+	array<ContextDictionary, D_MMC> M;
 
 	if(len < 3){	
 		printf("\t*** Warning: not enough samples to run multiMMC test (need more than %d) ***\n", 3);
@@ -164,84 +233,88 @@ double multi_mmc_test(uint8_t *data, long len, int alph_size, const int verbose,
 	N = len-2;
 
 	//Step 3
-	//scoreboard is initilized above.
-	winner = 0;
-	
-	C = 0;
-	run_len = 0;
-	max_run_len = 0;
+	initPredictorScoreboard(sb, D_MMC);
 
 	// initialize MMC counts
 	// this performs step 4.a and 4.b for the () case
-	memset(x.data(), 0, D_MMC);
 	for(d = 0; d < D_MMC; d++){
 		if(d < N){
-			memcpy(x.data(), data, d+1);
-			(M[d][x]).incrementPostfix(data[d+1], true);
+			x = contextWindow(data+d+1, d+1);
+			M[d].incrementPostfix(M[d].findOrCreate(x), data[d+1], true);
 			entries[d] = 1;
 		}
+		predicted[d].resize(PREDICTOR_CHUNK/64);
+		correct[d].resize(PREDICTOR_CHUNK/64);
 	}
 
+	//window holds the (up to) 16 symbols prior to S[i]; the length d+1 context is the low d+1 bytes.
+	window = contextWindow(data+2, 2);
+
 	// perform predictions
 	//i is the index of the new symbol to be predicted
-	for (i = 2; i < len; i++){
-		bool found_x = false;
-		cur_winner = winner;
-		memset(x.data(), 0, D_MMC);
-
-		for(d = 0; (d < D_MMC) && (i-2 >= d); d++) {
-			map<array<uint8_t, D_MMC>, PostfixDictionary>::iterator curp;
-			// check if x has been previously seen as a prefix. If the prefix x has not occurred,
-			// then do not make a prediction for current d and larger d's
-			// as well, since it will not occur for them either. In other words,
-			// prediction is NULL, so do not update the scoreboard.
-			// Note that found_x is uninitialized on the first round, but for that round d==0.
-			if((d == 0) || found_x) {
-				//Get the prediction
-				//predict S[i] by using the prior d+1 symbols and the current state
-				//We need the d-tuple prior to S[i], that is (S[i-d-1], ..., S[i-1])
-
-				//This populates the curp for the later increment
-
-				memcpy(x.data(), data+i-d-1, d+1);
-				curp = M[d].find(x);
-				if(curp == M[d].end()) found_x = false;
-				else found_x = true;
+	for(long start = 2; start < len; start += PREDICTOR_CHUNK){
+		const long end = (len-start > PREDICTOR_CHUNK) ? (start+PREDICTOR_CHUNK) : len;
+
+		if(parallelDepths){
+			// By observation 2 above, if a prefix has not occurred for some d, then the longer prefixes have not occurred either.
+			// The depths thus don't interact except through the scoreboard, so each depth is run (in parallel) over a chunk
+			// of the data, recording its predictions, and then the scoreboard is replayed for the chunk.
+			#pragma omp parallel for schedule(dynamic)
+			for(d = 0; d < D_MMC; d++) {
+				//The first prediction for this depth is for S[d+2]
+				const long first = (start >= d+2) ? start : (d+2);
+				const uint128_t mask = contextMask(d+1);
+				//depthWindow holds (at least) the d+1 symbols prior to S[i]
+				uint128_t depthWindow = contextWindow(data+first, d+1);
+
+				for(long b = start; b < end; b += 64){
+					uint64_t predictedMask = 0, correctMask = 0;
+
+					for(long i = (b >= first) ? b : first; (i < b+64) && (i < end); i++){
+						const int result = MMCStep(M[d], entries[d], depthWindow & mask, data[i], true);
+
+						predictedMask |= ((uint64_t)(result != MMC_NO_PREDICTION)) << (i-b);
+						correctMask |= ((uint64_t)(result == MMC_CORRECT)) << (i-b);
+						depthWindow = (depthWindow << 8) | data[i];
+					}
+
+					predicted[d][(b-start)>>6] = predictedMask;
+					correct[d][(b-start)>>6] = correctMask;
+				}
 			}
 
-			if(found_x){
-				long predictCount;
-				// x has occurred, find max (x,y) pair across all y's
-				// Check to see if the current prediction is correct.
-				if((curp->second).predict(predictCount) == data[i]){
-					// prediction is correct, update scoreboard and winner
-					if(++scoreboard[d] >= scoreboard[winner]) winner = d;
-					if(d == cur_winner){
-						C++;
-						if(++run_len > max_run_len) max_run_len = run_len;
+			replayScoreboardChunk(sb, predicted, correct, end-start);
+		} else {
+			for(long i = start; i < end; i++){
+				bool found_x = true;
+				const int cur_winner = sb.winner;
+
+				for(d = 0; (d < D_MMC) && (i-2 >= d); d++) {
+					//We need the d-tuple prior to S[i], that is (S[i-d-1], ..., S[i-1])
+					// If the prefix x has not occurred, then do not look for larger d's
+					// as well, since it will not occur for them either.
+					const int result = MMCStep(M[d], entries[d], window & contextMask(d+1), data[i], found_x);
+
+					found_x = (result != MMC_NO_PREDICTION);
+					if(result == MMC_CORRECT){
+						// prediction is correct, update scoreboard and winner
+						if(++sb.scoreboard[d] >= sb.scoreboard[sb.winner]) sb.winner = d;
+						if(d == cur_winner){
+							sb.C++;
+							if(++sb.run_len > sb.max_run_len) sb.max_run_len = sb.run_len;
+						}
+					}
+					else if((result == MMC_INCORRECT) && (d == cur_winner)) {
+						//This prediction was wrong;
+						//If the best predictor was previously d, zero the run length counter
+						sb.run_len = 0;
 					}
-				}
-				else if(d == cur_winner) {
-					//This prediction was wrong;
-					//If the best predictor was previously d, zero the run length counter
-					run_len = 0;
 				}
 
-				//Now check to see in (x,y) needs to be counted or (x,y) added to the dictionary
-				if((curp->second).incrementPostfix(data[i], entries[d] < MAX_ENTRIES)) {
-					//We had to make a new entry. Count this.
-					entries[d]++;
-				}
-			} else if(entries[d] < MAX_ENTRIES) {
-				//We didn't find the x prefix, so (x,y) surely can't have occurred.
-				//We're allowed to make a new entry. Do so.
-				//curp isn't populated here, because it wasn't found
-				memcpy(x.data(), data+i-d-1, d+1);
-				(M[d][x]).incrementPostfix(data[i], true);
-				entries[d]++;
+				window = (window << 8) | data[i];
 			}
 		}
 	}
 
-	return(predictionEstimate(C, N, max_run_len, alph_size, "MultiMMC", verbose, label));
+	return(predictionEstimate(sb.C, N, sb.max_run_len, alph_size, "MultiMMC", verbose, label));
 }
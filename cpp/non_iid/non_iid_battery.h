@@ -0,0 +1,334 @@
+#pragma once
+#include "../shared/utils.h"
+#include "../shared/most_common.h"
+#include "../shared/lrs_test.h"
+#include "non_iid_test_case.h"
+#include "collision_test.h"
+#include "lz78y_test.h"
+#include "multi_mmc_test.h"
+#include "lag_test.h"
+#include "multi_mcw_test.h"
+#include "compression_test.h"
+#include "markov_test.h"
+
+// Runs the non-IID estimators of Section 6.3 on the (loaded and translated) data, appending a test case for
+// each estimator, and then the overall assessment, to testCases. The estimators are run on the bitstring when the
+// symbols are not binary, or for the conditioned sequential dataset estimate (when initial_entropy is false).
+// The phases timed are added to phases (if not NULL).
+// Returns the assessed min-entropy per symbol, or -1.0 if the data has fewer than 2 distinct symbols.
+double nonIidBattery(data_t *dp, bool initial_entropy, int verbose, vector<NonIidTestCase> &testCases, PhaseTimings *phases = NULL) {
+	double H_original, H_bitstring, ret_min_entropy;
+	double bin_t_tuple_res = -1.0, bin_lrs_res = -1.0;
+	double t_tuple_res = -1.0, lrs_res = -1.0;
+
+	if (dp->alph_size <= 1) return -1.0;
+
+	// The maximum min-entropy is -log2(1/2^word_size) = word_size
+	// The maximum bit string min-entropy is 1.0
+	H_original = dp->word_size;
+	H_bitstring = 1.0;
+
+	if ((verbose == 1) || (verbose == 2)) {
+		printf("\nRunning non-IID tests...\n\n");
+		printf("Running Most Common Value Estimate...\n");
+	}
+
+	// Section 6.3.1 - Estimate entropy with Most Common Value
+	NonIidTestCase tc631;
+	PhaseTimer tc631Timer(tc631.timing);
+
+	if (((dp->alph_size > 2) || !initial_entropy)) {
+		ret_min_entropy = most_common(dp->bsymbols, dp->blen, 2, verbose, "Bitstring", tc631);
+		if (verbose == 2) printf("\tMost Common Value Estimate (bit string) = %f / 1 bit(s)\n", ret_min_entropy);
+		tc631.h_bitstring = ret_min_entropy;
+		H_bitstring = min(ret_min_entropy, H_bitstring);
+	}
+
+	if (initial_entropy) {
+		ret_min_entropy = most_common(dp->symbols, dp->len, dp->alph_size, verbose, "Literal", tc631);
+		if (verbose == 2) printf("\tMost Common Value Estimate = %f / %d bit(s)\n", ret_min_entropy, dp->word_size);
+		tc631.h_original = ret_min_entropy;
+		H_original = min(ret_min_entropy, H_original);
+	}
+
+	tc631.testCaseNumber = "Most Common Value";
+	tc631Timer.Stop();
+	testCases.push_back(tc631);
+
+	// Section 6.3.2 - Estimate entropy with Collision Test (for bit strings only)
+	NonIidTestCase tc632;
+	PhaseTimer tc632Timer(tc632.timing);
+
+	if ((verbose == 1) || (verbose == 2)) printf("\nRunning Entropic Statistic Estimates (bit strings only)...\n");
+
+	if (((dp->alph_size > 2) || !initial_entropy)) {
+		ret_min_entropy = collision_test(dp->bsymbols, dp->blen, verbose, "Bitstring");
+		if (verbose == 2) printf("\tCollision Test Estimate (bit string) = %f / 1 bit(s)\n", ret_min_entropy);
+		tc632.h_bitstring = ret_min_entropy;
+		H_bitstring = min(ret_min_entropy, H_bitstring);
+	}
+
+	if (initial_entropy && (dp->alph_size == 2)) {
+		ret_min_entropy = collision_test(dp->symbols, dp->len, verbose, "Literal");
+		if (verbose == 2) printf("\tCollision Test Estimate = %f / 1 bit(s)\n", ret_min_entropy);
+		tc632.h_original = ret_min_entropy;
+		H_original = min(ret_min_entropy, H_original);
+	}
+
+	tc632.testCaseNumber = "Collision Test (for bit strings only)";
+	tc632Timer.Stop();
+	testCases.push_back(tc632);
+
+	// Section 6.3.3 - Estimate entropy with Markov Test (for bit strings only)
+	NonIidTestCase tc633;
+	PhaseTimer tc633Timer(tc633.timing);
+
+	if (((dp->alph_size > 2) || !initial_entropy)) {
+		ret_min_entropy = markov_test(dp->bsymbols, dp->blen, verbose, "Bitstring");
+		if (verbose == 2) printf("\tMarkov Test Estimate (bit string) = %f / 1 bit(s)\n", ret_min_entropy);
+		tc633.h_bitstring = ret_min_entropy;
+		H_bitstring = min(ret_min_entropy, H_bitstring);
+	}
+
+	if (initial_entropy && (dp->alph_size == 2)) {
+		ret_min_entropy = markov_test(dp->symbols, dp->len, verbose, "Literal");
+		if (verbose == 2) printf("\tMarkov Test Estimate = %f / 1 bit(s)\n", ret_min_entropy);
+		tc633.h_original = ret_min_entropy;
+		H_original = min(ret_min_entropy, H_original);
+	}
+
+	tc633.testCaseNumber = "Markov Test (for bit strings only)";
+	tc633Timer.Stop();
+	testCases.push_back(tc633);
+
+	// Section 6.3.4 - Estimate entropy with Compression Test (for bit strings only)
+	NonIidTestCase tc634;
+	PhaseTimer tc634Timer(tc634.timing);
+
+	if (((dp->alph_size > 2) || !initial_entropy)) {
+		ret_min_entropy = compression_test(dp->bsymbols, dp->blen, verbose, "Bitstring");
+		if (ret_min_entropy >= 0) {
+			if (verbose == 2) printf("\tCompression Test Estimate (bit string) = %f / 1 bit(s)\n", ret_min_entropy);
+			tc634.h_bitstring = ret_min_entropy;
+			H_bitstring = min(ret_min_entropy, H_bitstring);
+		}
+	}
+
+	if (initial_entropy && (dp->alph_size == 2)) {
+		ret_min_entropy = compression_test(dp->symbols, dp->len, verbose, "Literal");
+		if (ret_min_entropy >= 0) {
+			if (verbose == 2) printf("\tCompression Test Estimate = %f / 1 bit(s)\n", ret_min_entropy);
+			tc634.h_original = ret_min_entropy;
+			H_original = min(ret_min_entropy, H_original);
+		}
+	}
+
+	tc634.testCaseNumber = "Compression Test (for bit strings only)";
+	tc634Timer.Stop();
+	testCases.push_back(tc634);
+
+	// Section 6.3.5 - Estimate entropy with t-Tuple Test
+	NonIidTestCase tc635;
+	PhaseTimer tc635Timer(tc635.timing);
+
+	if ((verbose == 1) || (verbose == 2)) printf("\nRunning Tuple Estimates...\n");
+
+	if (((dp->alph_size > 2) || !initial_entropy)) {
+		SAalgs(dp->bsymbols, dp->blen, 2, bin_t_tuple_res, bin_lrs_res, verbose, "Bitstring", phases);
+		if (bin_t_tuple_res >= 0.0) {
+			if (verbose == 2) printf("\tT-Tuple Test Estimate (bit string) = %f / 1 bit(s)\n", bin_t_tuple_res);
+			tc635.bin_t_tuple_res = bin_t_tuple_res;
+			H_bitstring = min(bin_t_tuple_res, H_bitstring);
+		}
+	}
+
+	if (initial_entropy) {
+		SAalgs(dp->symbols, dp->len, dp->alph_size, t_tuple_res, lrs_res, verbose, "Literal", phases);
+		if (t_tuple_res >= 0.0) {
+			if (verbose == 2) printf("\tT-Tuple Test Estimate = %f / %d bit(s)\n", t_tuple_res, dp->word_size);
+			tc635.t_tuple_res = t_tuple_res;
+			H_original = min(t_tuple_res, H_original);
+		}
+	}
+
+	tc635.testCaseNumber = "T-Tuple Test";
+	tc635Timer.Stop();
+	testCases.push_back(tc635);
+
+	// Section 6.3.6 - Estimate entropy with LRS Test
+	NonIidTestCase tc636;
+	PhaseTimer tc636Timer(tc636.timing);
+
+	if ((((dp->alph_size > 2) || !initial_entropy)) && (bin_lrs_res >= 0.0)) {
+		if (verbose == 2) printf("\tLRS Test Estimate (bit string) = %f / 1 bit(s)\n", bin_lrs_res);
+		tc636.bin_lrs_res = bin_lrs_res;
+		H_bitstring = min(bin_lrs_res, H_bitstring);
+	}
+
+	if (initial_entropy && (lrs_res >= 0.0)) {
+		if (verbose == 2) printf("\tLRS Test Estimate = %f / %d bit(s)\n", lrs_res, dp->word_size);
+		tc636.lrs_res = lrs_res;
+		H_original = min(lrs_res, H_original);
+	}
+
+	tc636.testCaseNumber = "LRS Test";
+	tc636Timer.Stop();
+	testCases.push_back(tc636);
+
+	// Section 6.3.7 - Estimate entropy with Multi Most Common in Window Test
+	NonIidTestCase tc637;
+	PhaseTimer tc637Timer(tc637.timing);
+
+	if ((verbose == 1) || (verbose == 2)) printf("\nRunning Predictor Estimates...\n");
+
+	if (((dp->alph_size > 2) || !initial_entropy)) {
+		ret_min_entropy = multi_mcw_test(dp->bsymbols, dp->blen, 2, verbose, "Bitstring");
+		if (ret_min_entropy >= 0) {
+			if (verbose == 2) printf("\tMulti Most Common in Window (MultiMCW) Prediction Test Estimate (bit string) = %f / 1 bit(s)\n", ret_min_entropy);
+			tc637.h_bitstring = ret_min_entropy;
+			H_bitstring = min(ret_min_entropy, H_bitstring);
+		}
+	}
+
+	if (initial_entropy) {
+		ret_min_entropy = multi_mcw_test(dp->symbols, dp->len, dp->alph_size, verbose, "Literal");
+		if (ret_min_entropy >= 0) {
+			if (verbose == 2) printf("\tMulti Most Common in Window (MultiMCW) Prediction Test Estimate = %f / %d bit(s)\n", ret_min_entropy, dp->word_size);
+			tc637.h_original = ret_min_entropy;
+			H_original = min(ret_min_entropy, H_original);
+		}
+	}
+
+	tc637.testCaseNumber = "Multi Most Common in Window Test";
+	tc637Timer.Stop();
+	testCases.push_back(tc637);
+
+	// Section 6.3.8 - Estimate entropy with Lag Prediction Test
+	NonIidTestCase tc638;
+	PhaseTimer tc638Timer(tc638.timing);
+
+	if (((dp->alph_size > 2) || !initial_entropy)) {
+		ret_min_entropy = lag_test(dp->bsymbols, dp->blen, 2, verbose, "Bitstring");
+		if (ret_min_entropy >= 0) {
+			if (verbose == 2) printf("\tLag Prediction Test Estimate (bit string) = %f / 1 bit(s)\n", ret_min_entropy);
+			tc638.h_bitstring = ret_min_entropy;
+			H_bitstring = min(ret_min_entropy, H_bitstring);
+		}
+	}
+
+	if (initial_entropy) {
+		ret_min_entropy = lag_test(dp->symbols, dp->len, dp->alph_size, verbose, "Literal");
+		if (ret_min_entropy >= 0) {
+			if (verbose == 2) printf("\tLag Prediction Test Estimate = %f / %d bit(s)\n", ret_min_entropy, dp->word_size);
+			tc638.h_original = ret_min_entropy;
+			H_original = min(ret_min_entropy, H_original);
+		}
+	}
+
+	tc638.testCaseNumber = "Lag Prediction Test";
+	tc638Timer.Stop();
+	testCases.push_back(tc638);
+
+	// Section 6.3.9 - Estimate entropy with Multi Markov Model with Counting Test (MultiMMC)
+	NonIidTestCase tc639;
+	PhaseTimer tc639Timer(tc639.timing);
+
+	if (((dp->alph_size > 2) || !initial_entropy)) {
+		ret_min_entropy = multi_mmc_test(dp->bsymbols, dp->blen, 2, verbose, "Bitstring");
+		if (ret_min_entropy >= 0) {
+			if (verbose == 2) printf("\tMulti Markov Model with Counting (MultiMMC) Prediction Test Estimate (bit string) = %f / 1 bit(s)\n", ret_min_entropy);
+			tc639.h_bitstring = ret_min_entropy;
+			H_bitstring = min(ret_min_entropy, H_bitstring);
+		}
+	}
+
+	if (initial_entropy) {
+		ret_min_entropy = multi_mmc_test(dp->symbols, dp->len, dp->alph_size, verbose, "Literal");
+		if (ret_min_entropy >= 0) {
+			if (verbose == 2) printf("\tMulti Markov Model with Counting (MultiMMC) Prediction Test Estimate = %f / %d bit(s)\n", ret_min_entropy, dp->word_size);
+			tc639.h_original = ret_min_entropy;
+			H_original = min(ret_min_entropy, H_original);
+		}
+	}
+
+	tc639.testCaseNumber = "Multi Markov Model with Counting Test (MultiMMC)";
+	tc639Timer.Stop();
+	testCases.push_back(tc639);
+
+	// Section 6.3.10 - Estimate entropy with LZ78Y Test
+	NonIidTestCase tc6310;
+	PhaseTimer tc6310Timer(tc6310.timing);
+
+	if (((dp->alph_size > 2) || !initial_entropy)) {
+		ret_min_entropy = LZ78Y_test(dp->bsymbols, dp->blen, 2, verbose, "Bitstring");
+		if (ret_min_entropy >= 0) {
+			if (verbose == 2) printf("\tLZ78Y Prediction Test Estimate (bit string) = %f / 1 bit(s)\n", ret_min_entropy);
+			tc6310.h_bitstring = ret_min_entropy;
+			H_bitstring = min(ret_min_entropy, H_bitstring);
+		}
+	}
+
+	if (initial_entropy) {
+		ret_min_entropy = LZ78Y_test(dp->symbols, dp->len, dp->alph_size, verbose, "Literal");
+		if (ret_min_entropy >= 0) {
+			if (verbose == 2) printf("\tLZ78Y Prediction Test Estimate = %f / %d bit(s)\n", ret_min_entropy, dp->word_size);
+			tc6310.h_original = ret_min_entropy;
+			H_original = min(ret_min_entropy, H_original);
+		}
+	}
+
+	tc6310.testCaseNumber = "LZ78Y Test";
+	tc6310Timer.Stop();
+	testCases.push_back(tc6310);
+
+	double h_assessed;
+	h_assessed = dp->word_size;
+
+	if ((dp->alph_size > 2) || !initial_entropy) {
+		h_assessed = min(h_assessed, H_bitstring * dp->word_size);
+	}
+
+	if (initial_entropy) {
+		h_assessed = min(h_assessed, H_original);
+	}
+
+	if ((verbose == 1) || (verbose == 2)) {
+		if (initial_entropy) {
+			printf("\nH_original: %f\n", H_original);
+			if (dp->alph_size > 2) {
+				printf("H_bitstring: %f\n", H_bitstring);
+				printf("min(H_original, %d X H_bitstring): %f\n", dp->word_size, min(H_original, dp->word_size * H_bitstring));
+			}
+		} else {
+			printf("\nh': %f\n", H_bitstring);
+		}
+	} else if (verbose > 2) {
+		if ((dp->alph_size > 2) || !initial_entropy) {
+			printf("H_bitstring = %.17g\n", H_bitstring);
+			printf("H_bitstring Per Symbol = %.17g\n", H_bitstring * dp->word_size);
+		}
+
+		if (initial_entropy) {
+			printf("H_original = %.17g\n", H_original);
+		}
+
+		printf("Assessed min entropy: %.17g\n", h_assessed);
+	}
+
+	NonIidTestCase tcOverall;
+
+	if ((dp->alph_size > 2) || !initial_entropy) {
+		tcOverall.h_bitstring = H_bitstring;
+	}
+
+	if (initial_entropy) {
+		tcOverall.h_original = H_original;
+	}
+
+	tcOverall.data_word_size = dp->word_size;
+	tcOverall.testCaseNumber = "Overall";
+	tcOverall.h_assessed = h_assessed;
+	testCases.push_back(tcOverall);
+
+	return h_assessed;
+}
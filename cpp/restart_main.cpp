@@ -1,22 +1,10 @@
-/* VERSION information is kept in utils.h. Please update when a new version is released */
-
-#include "shared/utils.h"
-#include "shared/most_common.h"
-#include "shared/lrs_test.h"
-#include "non_iid/non_iid_test_run.h"
-#include "iid/iid_test_run.h"
-#include "shared/TestRunUtils.h"
-#include "non_iid/collision_test.h"
-#include "non_iid/lz78y_test.h"
-#include "non_iid/multi_mmc_test.h"
-#include "non_iid/lag_test.h"
-#include "non_iid/multi_mcw_test.h"
-#include "non_iid/compression_test.h"
-#include "non_iid/markov_test.h"
-#include "iid/chi_square_tests.h"
-#include "iid/permutation_tests.h"
+/* VERSION information is kept in shared/data.h. Please update when a new version is released */
+
+#include "lib/entropy_assessment.h"
 
 #include <cstdint>
+#include <cmath>
+#include <assert.h>
 #include <getopt.h>
 #include <limits.h>
 #include <iostream>
@@ -26,8 +14,12 @@
 //Each test has a targeted chance of roughly 0.000005, and we need to witness at least 5 failures, so this should be no less than 1000000
 #define DEFAULT_SIMULATION_ROUNDS 5000000UL
 
+//The RNG streams used (see seed) for the row and column permutation tests (the simulation uses RESTART_SIMULATION_STREAM)
+#define RESTART_ROW_STREAM 1
+#define RESTART_COL_STREAM 2
+
 [[ noreturn ]] void print_usage() {
-    printf("Usage is: ea_restart [-i|-n] [-v] [-q] [-s <simulation count>] <file_name> [bits_per_symbol] <H_I>\n\n");
+    printf("Usage is: ea_restart [-i|-n] [-v] [-q] [-p] [-s <simulation count>] [--seed <hex>] [--profile] <file_name> [bits_per_symbol] <H_I>\n\n");
     printf("\t <file_name>: Must be relative path to a binary file with at least 1 million entries (samples),\n");
     printf("\t and in the \"row dataset\" format described in SP800-90B Section 3.1.4.1.\n");
     printf("\t [bits_per_symbol]: Must be between 1-8, inclusive.\n");
@@ -36,6 +28,11 @@
     printf("\t -s <simulation count>: Establish cutoff using <simulation count> rounds.\n");
     printf("\t -v: Optional verbosity flag for more output.\n");
     printf("\t -q: Quiet mode, less output to screen.\n");
+    printf("\t -p: Assess the row and column datasets in parallel (each using half of the available cores).\n");
+    printf("\t\t In this mode, the intermediate output of the individual tests (at verbosity levels above 1) is not shown.\n");
+    printf("\t --seed <hex>: Seed the random number generator with the (hexadecimal) value <hex>, rather than from /dev/urandom.\n");
+    printf("\t\t Runs with the same seed produce the same results, regardless of the number of threads used.\n");
+    printf("\t --profile: Print the time and memory used by each phase and each estimator. These are always included in the JSON output.\n");
     printf("\n");
     printf("\t Restart samples are assumed to be packed into 8-bit values, where the rightmost 'bits_per_symbol'\n");
     printf("\t bits constitute the sample.\n");
@@ -54,121 +51,107 @@
     exit(-1);
 }
 
-// Here, we simulate a "worst case" for the restart sanity test. This is "worst case" in the sense that the adopted distribution
-// results in the largest acceptable collision bound for a given assessed entropy level, so if a data sample fails this
-// test, it is likely to indicate an underlying problem.
-//
-// This "worst case" uses the "inverted near-uniform" family (see Hagerty-Draper "Entropy Bounds and Statistical Tests" for
-// a full definition of this distribution and justification for its use here).
-//
-// This distribution has as many maximal probability symbols as possible (each occurring with probability p), and possibly one
-// additional symbol that contains all the residual probability.
-//
-// If the probability for the most likely symbol is p, then there are floor(1/p) most likely symbols,
-// each occurring with probability p and possibly one additional symbol that has all the remaining (1 - p floor(1/p)) chance.
-// In this code, we generate a random unit value in the range [0, 1), and we need to map this to one of the ceil(1/p) possible
-// output symbols.
-//
-// Note that the function x -> floor(x/p) yields
-// [0p,1p) -> 0
-// [1p, 2p) -> 1
-// [2p, 3p) -> 2
-// ...
-// [(floor(1/p)-1)p, floor(1/p)p) -> floor(1/p)-1
-// [ floor(1/p)p, 1 ) -> floor(1/p)
-//
-// As such, each of the first floor(1/p) symbols (0 through floor(1/p)-1) have probability p of occurring, and
-// the symbol floor(1/p) has probability 1-floor(1/p)p of occurring, as desired.
-//
-// Note that if floor(1/p) = ceil(1/p) = 1/p, then there is no "residual" symbol, only 1/p most likely symbols.
-//
-// The array is 0-indexed, so we can use this map to establish the index directly.
-uint16_t simulateCount(int k_effective, double p, uint64_t *xoshiro256starstarState) {
-    uint16_t counts[256] = {0};
-    uint16_t max_count = 0;
-
-    for (int j = 0; j < 1000; j++) {
-        // Note that (int)floor(randomUnit(xoshiro256starstarState) / p) is the index map discussed in the above comments.
-        counts[(int)floor(randomUnit(xoshiro256starstarState) / p)]++;
-    }
-
-    // We could have tracked this during the above loop, but that would yield 1000 comparisons,
-    // rather than k_effective (<= 256) comparisons, as here.
-    for (int j = 0; j < k_effective; j++) {
-        if (max_count < counts[j]) max_count = counts[j];
+// The non-IID estimators that are run on each of the restart datasets, following the Most Common Value estimate
+#define RESTART_COLLISION 0
+#define RESTART_MARKOV 1
+#define RESTART_COMPRESSION 2
+#define RESTART_TTUPLE 3
+#define RESTART_LRS 4
+#define RESTART_MCW 5
+#define RESTART_LAG 6
+#define RESTART_MMC 7
+#define RESTART_LZ78Y 8
+#define RESTART_NONIID_TESTS 9
+
+struct restartNonIidTest {
+    const char *header; // Printed prior to this test (if not NULL)
+    const char *testCaseNumber;
+    const char *estimateName;
+    bool bitstringOnly;
+    bool skipNegative; // A negative result indicates that the test couldn't be run
+};
+
+static const restartNonIidTest restartNonIidTests[RESTART_NONIID_TESTS] = {
+    {"\nRunning Entropic Statistic Estimates (bit strings only)...\n", "Collision Test (for bit strings only)", "Collision Test Estimate", true, false},
+    {NULL, "Markov Test (for bit strings only)", "Markov Test Estimate", true, false},
+    {NULL, "Compression Test (for bit strings only)", "Compression Test Estimate", true, true},
+    {"\nRunning Tuple Estimates...\n", "T-Tuple Test", "T-Tuple Test Estimate", false, false},
+    {NULL, "LRS Test", "LRS Test Estimate", false, false},
+    {"\nRunning Predictor Estimates...\n", "Multi Most Common in Window Test", "Multi Most Common in Window (MultiMCW) Prediction Test Estimate", false, true},
+    {NULL, "Lag Prediction Test", "Lag Prediction Test Estimate", false, true},
+    {NULL, "Multi Markov Model with Counting Test (MultiMMC)", "Multi Markov Model with Counting (MultiMMC) Prediction Test Estimate", false, true},
+    {NULL, "LZ78Y Test", "LZ78Y Prediction Test Estimate", false, true}
+};
+
+// Runs the non-IID estimator "test" on S (the "Rows" or "Cols" dataset), and stores the result in est[test].
+// The t-tuple and LRS estimates are produced by the same call, so both are set when either is run.
+static void restartNonIidEstimate(int test, uint8_t *S, long len, int alph_size, int verbose, const char *dataset, double est[RESTART_NONIID_TESTS], PhaseTimings *phases) {
+    PhaseTimer estimateTimer(string(restartNonIidTests[test].testCaseNumber) + " (" + dataset + ")", phases);
+
+    switch (test) {
+        case RESTART_COLLISION:
+            est[test] = collision_test(S, len, verbose, "Literal");
+            break;
+        case RESTART_MARKOV:
+            est[test] = markov_test(S, len, verbose, "Literal");
+            break;
+        case RESTART_COMPRESSION:
+            est[test] = compression_test(S, len, verbose, "Literal");
+            break;
+        case RESTART_TTUPLE:
+        case RESTART_LRS:
+            SAalgs(S, len, alph_size, est[RESTART_TTUPLE], est[RESTART_LRS], verbose, "Literal", phases);
+            break;
+        case RESTART_MCW:
+            est[test] = multi_mcw_test(S, len, alph_size, verbose, "Literal");
+            break;
+        case RESTART_LAG:
+            est[test] = lag_test(S, len, alph_size, verbose, "Literal");
+            break;
+        case RESTART_MMC:
+            est[test] = multi_mmc_test(S, len, alph_size, verbose, "Literal");
+            break;
+        case RESTART_LZ78Y:
+            est[test] = LZ78Y_test(S, len, alph_size, verbose, "Literal");
+            break;
+        default:
+            assert(false);
     }
-
-    return max_count;
 }
 
-//This returns the bound (cutoff) for the test. Counts equal to this value should pass.
-//Larger values should fail.
-
-int simulateBound(double alpha, int k, double H_I, unsigned long int simulation_rounds) {
-    uint64_t xoshiro256starstarMainSeed[4];
-    uint16_t *results;
-    long int returnIndex;
-    double p;
-    int k_effective;
-    int returnValue;
-
-    assert((k > 1) && (k <= 256));
-
-    // A few constraints:
-    // This array may be very large (many gigabytes) so can't go onto the stack
-    // Many of the C++ STL-derived types are not thread safe. Our mode of access is
-    // quite straight forward, but there are clearly issues in some cases.
-    // In C, calloc is possibly faster, but this is probably the best we can do
-    // using somewhat idiomatic C++.
-    results = new uint16_t[simulation_rounds];
-    memset(results, 0, sizeof(uint16_t)*simulation_rounds);
-
-    //The probability of the most likely symbol (MLS) only needs to be calculated once...
-    p = pow(2.0, -H_I);
-
-    //if floor(1/p) = ceil(1/p) = 1/p, then there are exactly that many symbols (e.g., p=1/2, then there are 2 symbols expected).
-    //If ceil(1/p) > 1/p, then ceil(1/p) = floor(1/p)+1, that is there are the floor(1/p) most likely symbols, and then the extra
-    //symbol that fills the rest of the space (with probability < p).
-    k_effective = ceil(1.0 / p);
-    assert(k_effective <= k);
-
-    seed(xoshiro256starstarMainSeed);
-
-#pragma omp parallel
-    {
-        uint64_t xoshiro256starstarSeed[4];
-
-        memcpy(xoshiro256starstarSeed, xoshiro256starstarMainSeed, sizeof (xoshiro256starstarMainSeed));
-        //Cause the RNG to jump omp_get_thread_num() * 2^128 calls
-        xoshiro_jump(omp_get_thread_num(), xoshiro256starstarSeed);
-
-#pragma omp for
-        for (unsigned long int i = 0; i < simulation_rounds; i++) {
-            results[i] = simulateCount(k_effective, p, xoshiro256starstarSeed);
-        }
-    }
-
-    sort(results, results+simulation_rounds);
-    assert((results[0] >= (1000 / k)) && (results[0] <= 1000));
-    assert((results[simulation_rounds - 1] >= (1000 / k)) && (results[simulation_rounds - 1] <= 1000));
-
-    returnIndex = ((size_t) floor((1.0 - alpha) * ((double) simulation_rounds))) - 1;
-    assert((returnIndex >= 0) && (returnIndex < simulation_rounds));
+// Runs every applicable non-IID estimator on S (this is the battery run for each dataset when using -p).
+static void restartNonIidBattery(uint8_t *S, long len, int alph_size, int verbose, const char *dataset, double est[RESTART_NONIID_TESTS], PhaseTimings *phases) {
+    for (int t = 0; t < RESTART_NONIID_TESTS; t++) est[t] = -1.0;
 
-    returnValue = (int)results[returnIndex];
-
-    delete results;
+    for (int t = 0; t < RESTART_NONIID_TESTS; t++) {
+        if (restartNonIidTests[t].bitstringOnly && (alph_size != 2)) continue;
+        // The LRS estimate was found along with the t-tuple estimate
+        if (t == RESTART_LRS) continue;
+        restartNonIidEstimate(t, S, len, alph_size, verbose, dataset, est, phases);
+    }
+}
 
-    return returnValue;
+// The IID tests run on each of the restart datasets. The permutation test results are added to tc.
+struct restartIidResults {
+    bool chi_square_test_pass;
+    bool len_LRS_test_pass;
+    bool perm_test_pass;
+};
+
+static void restartIidBattery(const data_t *dp, double rawmean, double median, int verbose, uint64_t stream, IidTestCase &tc, restartIidResults &res, PhaseTimings *phases) {
+    res.chi_square_test_pass = chi_square_tests(dp->symbols, dp->len, dp->alph_size, verbose, phases);
+    res.len_LRS_test_pass = len_LRS_test(dp->symbols, dp->len, dp->alph_size, verbose, "Literal", phases);
+    res.perm_test_pass = permutation_tests(dp, rawmean, median, verbose, tc, stream, phases);
 }
 
 int main(int argc, char* argv[]) {
     bool iid;
     int verbose = 1; //verbose 0 is for JSON output, 1 is the normal mode, 2 is the NIST tool verbose mode, and 3 is for extra verbose output
     bool quietMode = false;
+    bool parallelBatteries = false;
     char *file_path;
     int r = 1000, c = 1000;
-    int counts[256];
+    long counts[256];
     unsigned long int simulation_rounds = DEFAULT_SIMULATION_ROUNDS;
     int X_cutoff;
     int i, j;
@@ -179,6 +162,13 @@ int main(int argc, char* argv[]) {
     unsigned long int inul;
     data_t data;
     int opt;
+    uint64_t fixedSeed;
+    bool profile = false;
+    static const struct option longOptions[] = {
+        {"seed", required_argument, NULL, 'S'},
+        {"profile", no_argument, NULL, 'P'},
+        {NULL, 0, NULL, 0}
+    };
 
     iid = false;
     data.word_size = 0;
@@ -196,7 +186,7 @@ int main(int argc, char* argv[]) {
         }
     }
 
-    while ((opt = getopt(argc, argv, "invqo:s:")) != -1) {
+    while ((opt = getopt_long(argc, argv, "invqpo:s:", longOptions, NULL)) != -1) {
         switch (opt) {
             case 'i':
                 iid = true;
@@ -210,6 +200,9 @@ int main(int argc, char* argv[]) {
             case 'q':
                 quietMode = true;
                 break;
+            case 'p':
+                parallelBatteries = true;
+                break;
             case 'o':
                 jsonOutput = true;
                 outputfilename = optarg;
@@ -222,6 +215,16 @@ int main(int argc, char* argv[]) {
                     simulation_rounds = inul;
                 }
                 break;
+            case 'S':
+                if (!parseFixedSeed(optarg, fixedSeed)) {
+                    printf("Invalid seed '%s'.\n", optarg);
+                    print_usage();
+                }
+                setFixedSeed(fixedSeed);
+                break;
+            case 'P':
+                profile = true;
+                break;
             default:
                 print_usage();
         }
@@ -243,17 +246,20 @@ int main(int argc, char* argv[]) {
 
     if (quietMode) verbose = 0;
 
+    IidTestRun testRunIid;
+    NonIidTestRun testRunNonIid;
+    // Only one of the test runs is reported, so the phases are recorded there
+    PhaseTimings *phases = iid ? &testRunIid.phases : &testRunNonIid.phases;
+
     char hash[2*SHA256_DIGEST_LENGTH+1];
-    sha256_file(file_path, hash);
+    sha256_file(file_path, hash, phases);
 
-    IidTestRun testRunIid;
     testRunIid.type = "Restart";
     testRunIid.timestamp = timestamp;
     testRunIid.filename = file_path;
     testRunIid.commandline = commandline;
     testRunIid.sha256 = hash;
 
-    NonIidTestRun testRunNonIid;
     testRunNonIid.type = "Restart";
     testRunNonIid.timestamp = timestamp;
     testRunNonIid.sha256 = hash;
@@ -316,7 +322,15 @@ int main(int argc, char* argv[]) {
 
     if (verbose > 1) printf("Opening file: '%s' (SHA-256 hash %s)\n", file_path, hash);
 
-    if (!read_file(file_path, &data, &testRunNonIid)) {
+    bool loaded = read_file(file_path, &data, &testRunNonIid);
+
+    // read_file records its phases (as well as its errors) in testRunNonIid
+    if (iid) {
+        vector<PhaseTiming> loadPhases = testRunNonIid.phases.Snapshot();
+        for (size_t p = 0; p < loadPhases.size(); p++) testRunIid.phases.Add(loadPhases[p]);
+    }
+
+    if (!loaded) {
         printf("Error reading file.\n");
 
         if (jsonOutput) {
@@ -442,18 +456,21 @@ int main(int argc, char* argv[]) {
     printf("H_I: %f\n", H_I);
 
     alpha = 1 - exp(log(0.99) / (r + c));
+    PhaseTimer simulationTimer("Sanity check simulation", phases);
     X_cutoff = simulateBound(alpha, data.alph_size, H_I, simulation_rounds);
+    simulationTimer.Stop();
     if (verbose > 0) printf("ALPHA: %.17g, X_cutoff: %d\n", alpha, X_cutoff);
 
     // get maximum row count
+    PhaseTimer sanityTimer("Sanity check", phases);
     X_r = 0;
     for (i = 0; i < r; i++) { //row
-        memset(counts, 0, 256 * sizeof (int));
+        //[i*r+j] is row i, column j
+        //So, we're fixing a row, and then iterate through various columns
+        histogram(rdata + i * r, c, data.alph_size, counts);
         X_i = 0;
-        for (j = 0; j < c; j++) {//column
-            //[i*r+j] is row i, column j
-            //So, we're fixing a row, and then iterate through various columns
-            if (++counts[rdata[i * r + j]] > X_i) X_i = counts[rdata[i * r + j]];
+        for (j = 0; j < data.alph_size; j++) {
+            if (counts[j] > X_i) X_i = (int)counts[j];
         }
         if (X_i > X_r) X_r = X_i;
     }
@@ -461,20 +478,23 @@ int main(int argc, char* argv[]) {
     // construct column data from row data and get maximum column count
     X_c = 0;
     for (j = 0; j < c; j++) { //columns
-        memset(counts, 0, 256 * sizeof (int));
-        X_i = 0;
         for (i = 0; i < r; i++) {
             //[i*r+j] is row i, column j
             //So, we're fixing a column and iterating through various rows
             cdata[j * c + i] = rdata[i * r + j];
             crawdata[j * c + i] = data.rawsymbols[i * r + j];
-            if (++counts[cdata[j * c + i]] > X_i) X_i = counts[cdata[j * c + i]];
+        }
+        histogram(cdata + j * c, r, data.alph_size, counts);
+        X_i = 0;
+        for (i = 0; i < data.alph_size; i++) {
+            if (counts[i] > X_i) X_i = (int)counts[i];
         }
         if (X_i > X_c) X_c = X_i;
     }
 
     // perform sanity check on rows and columns of restart data (Section 3.1.4.3)
     X_max = max(X_r, X_c);
+    sanityTimer.Stop();
     if (verbose > 0) printf("X_max: %d\n", X_max);
     if (X_max > X_cutoff) {
         if (verbose > 0) printf("\n*** Restart Sanity Check Failed ***\n");
@@ -521,6 +541,7 @@ int main(int argc, char* argv[]) {
     // Section 6.3.1 - Estimate entropy with Most Common Value
 
     NonIidTestCase tc631nonIid;
+    PhaseTimer tc631Timer(tc631nonIid.timing);
     tc631nonIid.testCaseNumber = "Most Common Value";
     tc631nonIid.data_word_size = data.word_size;
 
@@ -540,209 +561,129 @@ int main(int argc, char* argv[]) {
     tc631nonIid.h_c = ret_min_entropy;
     H_c = min(ret_min_entropy, H_c);
 
+    tc631Timer.Stop();
     testRunNonIid.testCases.push_back(tc631nonIid);
 
     IidTestCase tcOverallIid;
+    PhaseTimer tcOverallIidTimer(tcOverallIid.timing);
     tcOverallIid.h_r = H_r;
     tcOverallIid.h_c = H_c;
     tcOverallIid.h_i = H_I;
     tcOverallIid.testCaseNumber = "Overall";
 
 
-    if (!iid) {
-
-        if (data.alph_size == 2) {
-
-            if (verbose > 0) printf("\nRunning Entropic Statistic Estimates (bit strings only)...\n");
-
-            // Section 6.3.2 - Estimate entropy with Collision Test (for bit strings only)
-
-            NonIidTestCase tc632;
-            tc632.testCaseNumber = "Collision Test (for bit strings only)";
-            tc632.data_word_size = 1;
-            ret_min_entropy = collision_test(rdata, data.len, verbose, "Literal");
-            if (verbose > 1) printf("\tCollision Test Estimate (Rows) = %f / 1 bit(s)\n", ret_min_entropy);
-            tc632.h_r = ret_min_entropy;
-            H_r = min(ret_min_entropy, H_r);
-
-            ret_min_entropy = collision_test(cdata, data.len, verbose, "Literal");
-            if (verbose > 1) printf("\tCollision Test Estimate (Cols) = %f / 1 bit(s)\n", ret_min_entropy);
-            tc632.h_c = ret_min_entropy;
-            H_c = min(ret_min_entropy, H_c);
-
-            testRunNonIid.testCases.push_back(tc632);
+    // With -p, the rows and columns are each assessed by half of the cores. Both datasets are assessed before
+    // any of the results are reported, so the intermediate output of the tests themselves is suppressed.
+    const int batteryThreads = max(1, omp_get_max_threads() / 2);
+    const int batteryVerbose = min(verbose, 1);
 
-            // Section 6.3.3 - Estimate entropy with Markov Test (for bit strings only)
-
-            NonIidTestCase tc633;
-            tc633.testCaseNumber = "Markov Test (for bit strings only)";
-            tc633.data_word_size = 1;
-
-            ret_min_entropy = markov_test(rdata, data.len, verbose, "Literal");
-            if (verbose > 1) printf("\tMarkov Test Estimate (Rows) = %f / 1 bit(s)\n", ret_min_entropy);
-            tc633.h_r = ret_min_entropy;
-            H_r = min(ret_min_entropy, H_r);
-
-            ret_min_entropy = markov_test(cdata, data.len, verbose, "Literal");
-            if (verbose > 1) printf("\tMarkov Test Estimate (Cols) = %f / 1 bit(s)\n", ret_min_entropy);
-            tc633.h_c = ret_min_entropy;
-            H_c = min(ret_min_entropy, H_c);
-
-            testRunNonIid.testCases.push_back(tc633);
-
-            // Section 6.3.4 - Estimate entropy with Compression Test (for bit strings only)
+    if (!iid) {
+        double rowEst[RESTART_NONIID_TESTS], colEst[RESTART_NONIID_TESTS];
 
-            NonIidTestCase tc634;
-            tc634.testCaseNumber = "Compression Test (for bit strings only)";
-            tc634.data_word_size = 1;
+        if (parallelBatteries) {
+            omp_set_max_active_levels(2);
 
-            ret_min_entropy = compression_test(rdata, data.len, verbose, "Literal");
-            if (ret_min_entropy >= 0) {
-                if (verbose > 1) printf("\tCompression Test Estimate (Rows) = %f / 1 bit(s)\n", ret_min_entropy);
-                tc634.h_r = ret_min_entropy;
-                H_r = min(ret_min_entropy, H_r);
-            }
+            #pragma omp parallel sections num_threads(2)
+            {
+                #pragma omp section
+                {
+                    omp_set_num_threads(batteryThreads);
+                    restartNonIidBattery(rdata, data.len, data.alph_size, batteryVerbose, "Rows", rowEst, phases);
+                }
 
-            ret_min_entropy = compression_test(cdata, data.len, verbose, "Literal");
-            if (ret_min_entropy >= 0) {
-                if (verbose > 1) printf("\tCompression Test Estimate (Cols) = %f / 1 bit(s)\n", ret_min_entropy);
-                tc634.h_c = ret_min_entropy;
-                H_c = min(ret_min_entropy, H_c);
+                #pragma omp section
+                {
+                    omp_set_num_threads(batteryThreads);
+                    restartNonIidBattery(cdata, data.len, data.alph_size, batteryVerbose, "Cols", colEst, phases);
+                }
             }
-            testRunNonIid.testCases.push_back(tc634);
-
         }
 
+        for (int t = 0; t < RESTART_NONIID_TESTS; t++) {
+            const restartNonIidTest &test = restartNonIidTests[t];
+            const int wordSize = test.bitstringOnly ? 1 : data.word_size;
 
-        if (verbose > 0) printf("\nRunning Tuple Estimates...\n");
-
-        // Section 6.3.5 - Estimate entropy with t-Tuple Test
+            if (test.bitstringOnly && (data.alph_size != 2)) continue;
 
-        NonIidTestCase tc635;
-        tc635.testCaseNumber = "T-Tuple Test";
-        tc635.data_word_size = data.word_size;
+            if ((verbose > 0) && (test.header != NULL)) printf("%s", test.header);
 
-        double row_t_tuple_res, row_lrs_res;
-        double col_t_tuple_res, col_lrs_res;
-        SAalgs(rdata, data.len, data.alph_size, row_t_tuple_res, row_lrs_res, verbose, "Literal");
-        SAalgs(cdata, data.len, data.alph_size, col_t_tuple_res, col_lrs_res, verbose, "Literal");
-
-        if (verbose > 1) printf("\tT-Tuple Test Estimate (Rows) = %f / %d bit(s)\n", row_t_tuple_res, data.word_size);
-        tc635.h_r = row_t_tuple_res;
-        H_r = min(row_t_tuple_res, H_r);
-
-        if (verbose > 1) printf("\tT-Tuple Test Estimate (Cols) = %f / %d bit(s)\n", col_t_tuple_res, data.word_size);
-        tc635.h_c = col_t_tuple_res;
-        H_c = min(col_t_tuple_res, H_c);
-
-        testRunNonIid.testCases.push_back(tc635);
-        // Section 6.3.6 - Estimate entropy with LRS Test
-
-        NonIidTestCase tc636;
-        tc636.testCaseNumber = "LRS Test";
-        tc636.data_word_size = data.word_size;
-
-        if (verbose > 1) printf("\tLRS Test Estimate (Rows) = %f / %d bit(s)\n", row_lrs_res, data.word_size);
-        tc636.h_r = row_lrs_res;
-        H_r = min(row_lrs_res, H_r);
-
-        if (verbose > 1) printf("\tLRS Test Estimate (Cols) = %f / %d bit(s)\n", col_lrs_res, data.word_size);
-        tc636.h_c = col_lrs_res;
-        H_c = min(col_lrs_res, H_c);
-
-        testRunNonIid.testCases.push_back(tc636);
+            if (!parallelBatteries) {
+                if (t == RESTART_TTUPLE) {
+                    // Both the t-tuple and LRS estimates are found here, for both the rows and the columns
+                    restartNonIidEstimate(t, rdata, data.len, data.alph_size, verbose, "Rows", rowEst, phases);
+                    restartNonIidEstimate(t, cdata, data.len, data.alph_size, verbose, "Cols", colEst, phases);
+                } else if (t != RESTART_LRS) {
+                    restartNonIidEstimate(t, rdata, data.len, data.alph_size, verbose, "Rows", rowEst, phases);
+                }
+            }
 
-        if (verbose > 0) printf("\nRunning Predictor Estimates...\n");
+            NonIidTestCase tc;
+            // With -p, the estimates were all found beforehand, so their costs are only recorded as phases.
+            PhaseTimer tcTimer(tc.timing);
+            tc.testCaseNumber = test.testCaseNumber;
+            tc.data_word_size = wordSize;
 
-        // Section 6.3.7 - Estimate entropy with Multi Most Common in Window Test
+            if (!test.skipNegative || (rowEst[t] >= 0)) {
+                if (verbose > 1) printf("\t%s (Rows) = %f / %d bit(s)\n", test.estimateName, rowEst[t], wordSize);
+                tc.h_r = rowEst[t];
+                H_r = min(rowEst[t], H_r);
+            }
 
-        NonIidTestCase tc637;
-        tc637.testCaseNumber = "Multi Most Common in Window Test";
-        tc637.data_word_size = data.word_size;
+            if (!parallelBatteries && (t != RESTART_TTUPLE) && (t != RESTART_LRS)) {
+                restartNonIidEstimate(t, cdata, data.len, data.alph_size, verbose, "Cols", colEst, phases);
+            }
 
-        ret_min_entropy = multi_mcw_test(rdata, data.len, data.alph_size, verbose, "Literal");
-        if (ret_min_entropy >= 0) {
-            if (verbose > 1) printf("\tMulti Most Common in Window (MultiMCW) Prediction Test Estimate (Rows) = %f / %d bit(s)\n", ret_min_entropy, data.word_size);
-            tc637.h_r = ret_min_entropy;
-            H_r = min(ret_min_entropy, H_r);
-        }
+            if (!test.skipNegative || (colEst[t] >= 0)) {
+                if (verbose > 1) printf("\t%s (Cols) = %f / %d bit(s)\n", test.estimateName, colEst[t], wordSize);
+                tc.h_c = colEst[t];
+                H_c = min(colEst[t], H_c);
+            }
 
-        ret_min_entropy = multi_mcw_test(cdata, data.len, data.alph_size, verbose, "Literal");
-        if (ret_min_entropy >= 0) {
-            if (verbose > 1) printf("\tMulti Most Common in Window (MultiMCW) Prediction Test Estimate (Cols) = %f / %d bit(s)\n", ret_min_entropy, data.word_size);
-            tc637.h_c = ret_min_entropy;
-            H_c = min(ret_min_entropy, H_c);
+            tcTimer.Stop();
+            if (parallelBatteries) tc.timing.recorded = false;
+            testRunNonIid.testCases.push_back(tc);
         }
 
-        testRunNonIid.testCases.push_back(tc637);
-        // Section 6.3.8 - Estimate entropy with Lag Prediction Test
-
-        NonIidTestCase tc638;
-        tc638.testCaseNumber = "Lag Prediction Test";
-        tc638.data_word_size = data.word_size;
-
-        ret_min_entropy = lag_test(rdata, data.len, data.alph_size, verbose, "Literal");
-        if (ret_min_entropy >= 0) {
-            if (verbose > 1) printf("\tLag Prediction Test Estimate (Rows) = %f / %d bit(s)\n", ret_min_entropy, data.word_size);
-            tc638.h_r = ret_min_entropy;
-            H_r = min(ret_min_entropy, H_r);
-        }
+    } else { /* IID tests */
+        restartIidResults rowRes, colRes;
 
-        ret_min_entropy = lag_test(cdata, data.len, data.alph_size, verbose, "Literal");
-        if (ret_min_entropy >= 0) {
-            if (verbose > 1) printf("\tLag Prediction Test Estimate (Cols) = %f / %d bit(s)\n", ret_min_entropy, data.word_size);
-            tc638.h_c = ret_min_entropy;
-            H_c = min(ret_min_entropy, H_c);
-        }
-        testRunNonIid.testCases.push_back(tc638);
-
-        // Section 6.3.9 - Estimate entropy with Multi Markov Model with Counting Test (MultiMMC)
-        NonIidTestCase tc639;
-        tc639.testCaseNumber = "Multi Markov Model with Counting Test (MultiMMC)";
-        tc639.data_word_size = data.word_size;
-
-        ret_min_entropy = multi_mmc_test(rdata, data.len, data.alph_size, verbose, "Literal");
-        if (ret_min_entropy >= 0) {
-            if (verbose > 1) printf("\tMulti Markov Model with Counting (MultiMMC) Prediction Test Estimate (Rows) = %f / %d bit(s)\n", ret_min_entropy, data.word_size);
-            tc639.h_r = ret_min_entropy;
-            H_r = min(ret_min_entropy, H_r);
-        }
+        data_t data_col;
+        // He rest of the data_col entries are invariant under permutation, so we just copy them.
+        memcpy(&data_col, &data, sizeof(data));
+        // Both the translated and raw data are used, and are not invariant under permutation
+        data_col.symbols = cdata;
+        data_col.rawsymbols = crawdata;
 
-        ret_min_entropy = multi_mmc_test(cdata, data.len, data.alph_size, verbose, "Literal");
-        if (ret_min_entropy >= 0) {
-            if (verbose > 1) printf("\tMulti Markov Model with Counting (MultiMMC) Prediction Test Estimate (Cols) = %f / %d bit(s)\n", ret_min_entropy, data.word_size);
-            tc639.h_c = ret_min_entropy;
-            H_c = min(ret_min_entropy, H_c);
-        }
-        testRunNonIid.testCases.push_back(tc639);
+        if (parallelBatteries) {
+            IidTestCase tcRow, tcCol;
 
-        // Section 6.3.10 - Estimate entropy with LZ78Y Test
+            omp_set_max_active_levels(2);
 
-        NonIidTestCase tc6310;
-        tc6310.testCaseNumber = "LZ78Y Test";
-        tc6310.data_word_size = data.word_size;
+            #pragma omp parallel sections num_threads(2)
+            {
+                #pragma omp section
+                {
+                    omp_set_num_threads(batteryThreads);
+                    restartIidBattery(&data, rawmean, median, batteryVerbose, RESTART_ROW_STREAM, tcRow, rowRes, phases);
+                }
 
-        ret_min_entropy = LZ78Y_test(rdata, data.len, data.alph_size, verbose, "Literal");
-        if (ret_min_entropy >= 0) {
-            if (verbose > 1) printf("\tLZ78Y Prediction Test Estimate (Rows) = %f / %d bit(s)\n", ret_min_entropy, data.word_size);
-            tc6310.h_r = ret_min_entropy;
-            H_r = min(ret_min_entropy, H_r);
-        }
+                #pragma omp section
+                {
+                    omp_set_num_threads(batteryThreads);
+                    restartIidBattery(&data_col, rawmean, median, batteryVerbose, RESTART_COL_STREAM, tcCol, colRes, phases);
+                }
+            }
 
-        ret_min_entropy = LZ78Y_test(cdata, data.len, data.alph_size, verbose, "Literal");
-        if (ret_min_entropy >= 0) {
-            if (verbose > 1) printf("\tLZ78Y Prediction Test Estimate (Cols) = %f / %d bit(s)\n", ret_min_entropy, data.word_size);
-            tc6310.h_c = ret_min_entropy;
-            H_c = min(ret_min_entropy, H_c);
+            // The permutation test results are recorded in the same order as in the sequential case
+            tcOverallIid.testResults.insert(tcOverallIid.testResults.end(), tcRow.testResults.begin(), tcRow.testResults.end());
+            tcOverallIid.testResults.insert(tcOverallIid.testResults.end(), tcCol.testResults.begin(), tcCol.testResults.end());
+        } else {
+            // Compute chi square stats
+            rowRes.chi_square_test_pass = chi_square_tests(rdata, sample_size, alphabet_size, verbose, phases);
+            colRes.chi_square_test_pass = chi_square_tests(cdata, sample_size, alphabet_size, verbose, phases);
         }
-        testRunNonIid.testCases.push_back(tc6310);
-
-    } else { /* IID tests */
 
-        // Compute chi square stats
-        bool chi_square_test_pass_row = chi_square_tests(rdata, sample_size, alphabet_size, verbose);
-        bool chi_square_test_pass_col = chi_square_tests(cdata, sample_size, alphabet_size, verbose);
-        bool chi_square_test_pass = chi_square_test_pass_row && chi_square_test_pass_col;
+        bool chi_square_test_pass = rowRes.chi_square_test_pass && colRes.chi_square_test_pass;
 
         tcOverallIid.passed_chi_square_tests = chi_square_test_pass;
 
@@ -763,10 +704,13 @@ int main(int argc, char* argv[]) {
             }
         }
 
-        // Compute length of the longest repeated substring stats
-        bool len_LRS_test_pass_row = len_LRS_test(rdata, sample_size, alphabet_size, verbose, "Literal");
-        bool len_LRS_test_pass_col = len_LRS_test(cdata, sample_size, alphabet_size, verbose, "Literal");
-        bool len_LRS_test_pass = len_LRS_test_pass_row && len_LRS_test_pass_col;
+        if (!parallelBatteries) {
+            // Compute length of the longest repeated substring stats
+            rowRes.len_LRS_test_pass = len_LRS_test(rdata, sample_size, alphabet_size, verbose, "Literal", phases);
+            colRes.len_LRS_test_pass = len_LRS_test(cdata, sample_size, alphabet_size, verbose, "Literal", phases);
+        }
+
+        bool len_LRS_test_pass = rowRes.len_LRS_test_pass && colRes.len_LRS_test_pass;
 
         tcOverallIid.passed_longest_repeated_substring_test = len_LRS_test_pass;
 
@@ -787,19 +731,13 @@ int main(int argc, char* argv[]) {
             }
         }
 
-        // Compute permutation stats
-        bool perm_test_pass_row = permutation_tests(&data, rawmean, median, verbose, tcOverallIid);
-
-        data_t data_col;
-        // He rest of the data_col entries are invariant under permutation, so we just copy them.
-        memcpy(&data_col, &data, sizeof(data));
-        // Both the translated and raw data are used, and are not invariant under permutation
-        data_col.symbols = cdata;
-        data_col.rawsymbols = crawdata;
-
-        bool perm_test_pass_col = permutation_tests(&data_col, rawmean, median, verbose, tcOverallIid);
+        if (!parallelBatteries) {
+            // Compute permutation stats
+            rowRes.perm_test_pass = permutation_tests(&data, rawmean, median, verbose, tcOverallIid, RESTART_ROW_STREAM, phases);
+            colRes.perm_test_pass = permutation_tests(&data_col, rawmean, median, verbose, tcOverallIid, RESTART_COL_STREAM, phases);
+        }
 
-        bool perm_test_pass = perm_test_pass_row && perm_test_pass_col;
+        bool perm_test_pass = rowRes.perm_test_pass && colRes.perm_test_pass;
 
         tcOverallIid.passed_iid_permutation_tests = perm_test_pass;
 
@@ -819,8 +757,6 @@ int main(int argc, char* argv[]) {
                 printf("IID permutation tests: Failed\n");
             }
         }
-
-
     }
 
     if (verbose > 0) {
@@ -854,6 +790,7 @@ int main(int argc, char* argv[]) {
     }
 
 
+    tcOverallIidTimer.Stop();
     testRunIid.testCases.push_back(tcOverallIid);
     testRunIid.errorLevel = 0;
 
@@ -865,6 +802,10 @@ int main(int argc, char* argv[]) {
     testRunNonIid.testCases.push_back(tcOverallNonIid);
     testRunNonIid.errorLevel = 0;
 
+    if (profile) {
+        if (iid) testRunIid.PrintTiming();
+        else testRunNonIid.PrintTiming();
+    }
 
     if (jsonOutput) {
         ofstream output;
@@ -1,6 +1,9 @@
 #!/usr/bin/perl
 
-# selftest-compareresults.pl <new data> <reference data>
+# selftest-compareresults.pl [-a] <new data> <reference data>
+#
+# By default, the estimates are compared. With -a, the whole output is compared line by line: the text of each
+# line must match, and the numbers within each line must agree (to within the same tolerance).
 
 use strict;
 
@@ -8,6 +11,12 @@ my $retstatus = 0;
 
 my $epsilon = 1.0E-10;
 my $maxdelta = 0;
+my $number = qr/[-+]?[0-9]*\.?[0-9]+(?:[eE][-+]?[0-9]+)?/;
+
+if((@ARGV > 0) && ($ARGV[0] eq '-a')) {
+   shift @ARGV;
+   exit compareLines($ARGV[0], $ARGV[1]);
+}
 
 open my $local_fh, '<', $ARGV[0] or die "Can't open $ARGV[0]: $!";
 my $newResults = resultsHash($local_fh);
@@ -19,22 +28,11 @@ close $local_reffh;
 
 foreach my $refKey (keys %$refResults) {
    if(exists($newResults->{$refKey})) {
-      my $maxval = (abs($refResults->{$refKey})>=abs($newResults->{$refKey})?abs($refResults->{$refKey}):abs($newResults->{$refKey}));
-
-      my $absdelta = abs($refResults->{$refKey} - $newResults->{$refKey});
-
-      my $reldelta;
       my $delta;
 
       #print "item: $refKey\n";
 
-      if($maxval > 0.0) {
-      	$reldelta = $absdelta / $maxval;
-      } else {
-        $reldelta = 0.0;
-      }
-
-      $delta = ($absdelta <= $reldelta) ? $absdelta : $reldelta;
+      $delta = relativeDelta($refResults->{$refKey}, $newResults->{$refKey});
       if($delta > $maxdelta) {
          $maxdelta = $delta;
       }
@@ -78,3 +76,68 @@ sub resultsHash {
   return \%input; # return hash reference
 }
 
+# The smaller of the absolute and relative differences between the two values
+sub relativeDelta {
+   my ($ref, $new) = @_;
+   my $maxval = (abs($ref)>=abs($new)?abs($ref):abs($new));
+   my $absdelta = abs($ref - $new);
+   my $reldelta;
+
+   if($maxval > 0.0) {
+      $reldelta = $absdelta / $maxval;
+   } else {
+      $reldelta = 0.0;
+   }
+
+   return ($absdelta <= $reldelta) ? $absdelta : $reldelta;
+}
+
+# Compare every line of the two files (see -a above)
+sub compareLines {
+   my ($newFile, $refFile) = @_;
+   my $status = 0;
+
+   open my $new_fh, '<', $newFile or die "Can't open $newFile: $!";
+   my @newLines = <$new_fh>;
+   close $new_fh;
+
+   open my $ref_fh, '<', $refFile or die "Can't open $refFile: $!";
+   my @refLines = <$ref_fh>;
+   close $ref_fh;
+
+   if(@newLines != @refLines) {
+      print "$newFile: " . scalar(@newLines) . " lines, but the reference has " . scalar(@refLines) . " lines\n";
+      $status = 1;
+   }
+
+   for(my $i = 0; ($i < @newLines) && ($i < @refLines); $i++) {
+      my @newValues = ($newLines[$i] =~ /$number/g);
+      my @refValues = ($refLines[$i] =~ /$number/g);
+      (my $newText = $newLines[$i]) =~ s/$number/#/g;
+      (my $refText = $refLines[$i]) =~ s/$number/#/g;
+
+      if($newText ne $refText) {
+         chomp(my $refLine = $refLines[$i]);
+         chomp(my $newLine = $newLines[$i]);
+         print "$newFile:" . ($i+1) . ": Line differs (reference: '$refLine' new: '$newLine')\n";
+         $status = 1;
+         next;
+      }
+
+      for(my $j = 0; $j < @refValues; $j++) {
+         my $delta = relativeDelta($refValues[$j], $newValues[$j]);
+
+         if($delta > $maxdelta) {
+            $maxdelta = $delta;
+         }
+
+         if($delta >= $epsilon) {
+            print "$newFile:" . ($i+1) . ": Significant difference (reference: $refValues[$j] new: $newValues[$j] delta: $delta)\n";
+            $status = 1;
+         }
+      }
+   }
+
+   print "Maximum delta: $maxdelta\n";
+   return $status;
+}
@@ -0,0 +1,66 @@
+Opening file: '../../bin/biased-random-bits.bin' (SHA-256 hash 481cdac6e2d65d45656c21234125eaf26df18a49037f15ffd40002b35e547586), reading block 0 of size 20000
+Loaded 20000 samples of 2 distinct 1-bit-wide symbols
+
+*** Warning: data contains less than 1000000 samples ***
+
+Raw Mean = 0.02095
+Median = 0.5
+Binary = true
+H_original = 0.026706722689204106
+Assessed min entropy: 0.026706722689204106
+Chi square independence: T = 0
+Chi square independence: df = 0
+Chi square independence: P-value = 1
+Chi square goodness of fit: T = 8.4076437157982404
+Chi square goodness of fit: df = 9
+Chi square goodness of fit: P-value = 0.49364381416970149
+Literal Longest Repeated Substring results: P_col = 0.9589778049999999526612
+Literal Longest Repeated Substring results: W = 357
+Literal Longest Repeated Substring results: Pr(X >= 1) = 1
+Permutation testing: Unpermuted result excursion = 9.53359999999999807585
+Permutation testing: Unpermuted result numDirectionalRuns = 647
+Permutation testing: Unpermuted result lenDirectionalRuns = 37
+Permutation testing: Unpermuted result numIncreasesDecreases = 2172
+Permutation testing: Unpermuted result numRunsMedian = 811
+Permutation testing: Unpermuted result lenRunsMedian = 299
+Permutation testing: Unpermuted result avgCollision = 2.347744360902255689183
+Permutation testing: Unpermuted result maxCollision = 6
+Permutation testing: Unpermuted result periodicity(1) = 1841
+Permutation testing: Unpermuted result periodicity(2) = 1819
+Permutation testing: Unpermuted result periodicity(8) = 1827
+Permutation testing: Unpermuted result periodicity(16) = 1811
+Permutation testing: Unpermuted result periodicity(32) = 1810
+Permutation testing: Unpermuted result covariance(1) = 73
+Permutation testing: Unpermuted result covariance(2) = 64
+Permutation testing: Unpermuted result covariance(8) = 66
+Permutation testing: Unpermuted result covariance(16) = 60
+Permutation testing: Unpermuted result covariance(32) = 67
+Permutation testing: Unpermuted result compression = 690
+
+
+                statistic  C[i][0]  C[i][1]  C[i][2]
+----------------------------------------------------
+                excursion     131       0       6
+       numDirectionalRuns      27       2       4
+       lenDirectionalRuns       6       1       5
+    numIncreasesDecreases       6       0      33
+            numRunsMedian      62       3       3
+            lenRunsMedian       8       0       6
+             avgCollision      24       0       6
+             maxCollision       2       4       3
+           periodicity(1)       5       1      20
+           periodicity(2)      44       0       6
+           periodicity(8)       6       1       5
+          periodicity(16)      15       1       5
+          periodicity(32)       6       0       6
+            covariance(1)       5       1       9
+            covariance(2)      27       0       6
+            covariance(8)      15       0       6
+           covariance(16)      23       2       4
+           covariance(32)      13       0       6
+              compression       5       1      14
+(* denotes failed test)
+
+Chi square tests: Passed
+Length of longest repeated substring test: Passed
+IID permutation tests: Passed
@@ -0,0 +1,69 @@
+Opening file: '../../bin/biased-random-bytes.bin' (SHA-256 hash 146bd7497d8e2d61a6e8559c9342ee79f6005a390ee4d776ba43500d00eb508d), reading block 0 of size 20000
+Loaded 20000 samples of 256 distinct 8-bit-wide symbols
+Number of Binary samples: 160000
+
+*** Warning: data contains less than 1000000 samples ***
+
+Raw Mean = 25.431750000000001
+Median = 0
+Binary = false
+H_bitstring = 0.1485330405062241
+H_bitstring Per Symbol = 1.1882643240497928
+H_original = 0.30876057787482247
+Assessed min entropy: 0.30876057787482247
+Chi square independence: T = 361.09607810979134
+Chi square independence: df = 280
+Chi square independence: P-value = 0.00076142498279132805
+Chi square goodness of fit: T = 565.53326842835861
+Chi square goodness of fit: df = 621
+Chi square goodness of fit: P-value = 0.94567387762713517
+Literal Longest Repeated Substring results: P_col = 0.6402473000000000629729
+Literal Longest Repeated Substring results: W = 34
+Literal Longest Repeated Substring results: Pr(X >= 1) = 1
+Permutation testing: Unpermuted result excursion = 8496.960750000007465133
+Permutation testing: Unpermuted result numDirectionalRuns = 6486
+Permutation testing: Unpermuted result lenDirectionalRuns = 35
+Permutation testing: Unpermuted result numIncreasesDecreases = 16370
+Permutation testing: Unpermuted result numRunsMedian = 1
+Permutation testing: Unpermuted result lenRunsMedian = 20000
+Permutation testing: Unpermuted result avgCollision = 2.499062851430713383394
+Permutation testing: Unpermuted result maxCollision = 9
+Permutation testing: Unpermuted result periodicity(1) = 12818
+Permutation testing: Unpermuted result periodicity(2) = 12813
+Permutation testing: Unpermuted result periodicity(8) = 12802
+Permutation testing: Unpermuted result periodicity(16) = 12813
+Permutation testing: Unpermuted result periodicity(32) = 12765
+Permutation testing: Unpermuted result covariance(1) = 14067993
+Permutation testing: Unpermuted result covariance(2) = 12728298
+Permutation testing: Unpermuted result covariance(8) = 13264532
+Permutation testing: Unpermuted result covariance(16) = 13205466
+Permutation testing: Unpermuted result covariance(32) = 12523680
+Permutation testing: Unpermuted result compression = 7661
+
+
+                statistic  C[i][0]  C[i][1]  C[i][2]
+----------------------------------------------------
+                excursion       6       0      37
+       numDirectionalRuns      15       0       6
+       lenDirectionalRuns      17       3       3
+    numIncreasesDecreases      82       0       6
+            numRunsMedian       0       6       0
+            lenRunsMedian       0       6       0
+             avgCollision       6       0      19
+             maxCollision       2       4       2
+           periodicity(1)       5       1      15
+           periodicity(2)       6       0       6
+           periodicity(8)      12       0       6
+          periodicity(16)       6       0      25
+          periodicity(32)      23       2       4
+            covariance(1)       6       0     241
+            covariance(2)      13       0       6
+            covariance(8)       6       0      10
+           covariance(16)       6       0      10
+           covariance(32)      23       0       6
+              compression       6       0      17
+(* denotes failed test)
+
+Chi square tests: Failed
+Length of longest repeated substring test: Passed
+IID permutation tests: Passed
@@ -0,0 +1,66 @@
+Opening file: '../../bin/data.pi.bin' (SHA-256 hash d9a7de4e1f170f363bcb2a85570e4b6ed2320d5500abc5795bc4bfadcb93b928), reading block 0 of size 20000
+Loaded 20000 samples of 2 distinct 1-bit-wide symbols
+
+*** Warning: data contains less than 1000000 samples ***
+
+Raw Mean = 0.56769999999999998
+Median = 0.5
+Binary = true
+H_original = 0.79404880588518467
+Assessed min entropy: 0.79404880588518467
+Chi square independence: T = 306.76947537059658
+Chi square independence: df = 126
+Chi square independence: P-value = 4.2487174625422167e-17
+Chi square goodness of fit: T = 9.600813245357255
+Chi square goodness of fit: df = 9
+Chi square goodness of fit: P-value = 0.38375681392583127
+Literal Longest Repeated Substring results: P_col = 0.5091665799999999952484
+Literal Longest Repeated Substring results: W = 31
+Literal Longest Repeated Substring results: Pr(X >= 1) = 0.1504641065866388013081
+Permutation testing: Unpermuted result excursion = 49.89799999999991797495
+Permutation testing: Unpermuted result numDirectionalRuns = 1650
+Permutation testing: Unpermuted result lenDirectionalRuns = 7
+Permutation testing: Unpermuted result numIncreasesDecreases = 1437
+Permutation testing: Unpermuted result numRunsMedian = 8950
+Permutation testing: Unpermuted result lenRunsMedian = 15
+Permutation testing: Unpermuted result avgCollision = 18.744360902255639445
+Permutation testing: Unpermuted result maxCollision = 57
+Permutation testing: Unpermuted result periodicity(1) = 386
+Permutation testing: Unpermuted result periodicity(2) = 400
+Permutation testing: Unpermuted result periodicity(8) = 448
+Permutation testing: Unpermuted result periodicity(16) = 462
+Permutation testing: Unpermuted result periodicity(32) = 469
+Permutation testing: Unpermuted result covariance(1) = 51006
+Permutation testing: Unpermuted result covariance(2) = 51004
+Permutation testing: Unpermuted result covariance(8) = 51301
+Permutation testing: Unpermuted result covariance(16) = 50699
+Permutation testing: Unpermuted result covariance(32) = 51462
+Permutation testing: Unpermuted result compression = 3115
+
+
+                statistic  C[i][0]  C[i][1]  C[i][2]
+----------------------------------------------------
+                excursion       6       0       6
+       numDirectionalRuns       6       0    1645
+       lenDirectionalRuns       5       3       3
+   numIncreasesDecreases*   10000       0       0
+           numRunsMedian*   10000       0       0
+            lenRunsMedian      12       3       3
+             avgCollision      24       0       6
+             maxCollision       6       0     112
+          periodicity(1)*   10000       0       0
+          periodicity(2)*   10000       0       0
+           periodicity(8)     455       2       4
+          periodicity(16)      74       0       6
+          periodicity(32)      50       0       6
+           covariance(1)*   10000       0       0
+           covariance(2)*   10000       0       0
+            covariance(8)      35       0       6
+          covariance(16)*   10000       0       0
+          covariance(32)*       0       0   10000
+             compression*   10000       0       0
+(* denotes failed test)
+
+Chi square tests: Failed
+Length of longest repeated substring test: Passed
+IID permutation tests: Failed
@@ -0,0 +1,71 @@
+Opening file: '../../bin/normal.bin' (SHA-256 hash a70ce92a71b9b0c6dee80335ef570dea618631ee64cc735b033e9f402f14bc7d), reading block 0 of size 20000
+Loaded 20000 samples of 145 distinct 8-bit-wide symbols
+Number of Binary samples: 160000
+
+*** Warning: data contains less than 1000000 samples ***
+
+
+Samples have been translated
+Raw Mean = 126.5727
+Median = 72
+Binary = false
+H_bitstring = 0.98864450619006949
+H_bitstring Per Symbol = 7.909156049520556
+H_original = 5.4043577108998218
+Assessed min entropy: 5.4043577108998218
+Chi square independence: T = 1580.427239676311
+Chi square independence: df = 1551
+Chi square independence: P-value = 0.29563215760266198
+Chi square goodness of fit: T = 816.08830164015819
+Chi square goodness of fit: df = 837
+Chi square goodness of fit: P-value = 0.69114451389068177
+Literal Longest Repeated Substring results: P_col = 0.01411180499999999994857
+Literal Longest Repeated Substring results: W = 4
+Literal Longest Repeated Substring results: Pr(X >= 1) = 0.9996397867869072155185
+Permutation testing: Unpermuted result excursion = 1521.153200000039987572
+Permutation testing: Unpermuted result numDirectionalRuns = 13303
+Permutation testing: Unpermuted result lenDirectionalRuns = 7
+Permutation testing: Unpermuted result numIncreasesDecreases = 10173
+Permutation testing: Unpermuted result numRunsMedian = 10052
+Permutation testing: Unpermuted result lenRunsMedian = 13
+Permutation testing: Unpermuted result avgCollision = 11.40193842645381927525
+Permutation testing: Unpermuted result maxCollision = 30
+Permutation testing: Unpermuted result periodicity(1) = 275
+Permutation testing: Unpermuted result periodicity(2) = 285
+Permutation testing: Unpermuted result periodicity(8) = 260
+Permutation testing: Unpermuted result periodicity(16) = 272
+Permutation testing: Unpermuted result periodicity(32) = 279
+Permutation testing: Unpermuted result covariance(1) = 320347481
+Permutation testing: Unpermuted result covariance(2) = 320337834
+Permutation testing: Unpermuted result covariance(8) = 320306061
+Permutation testing: Unpermuted result covariance(16) = 320057296
+Permutation testing: Unpermuted result covariance(32) = 319842507
+Permutation testing: Unpermuted result compression = 17207
+
+
+                statistic  C[i][0]  C[i][1]  C[i][2]
+----------------------------------------------------
+                excursion      62       0       6
+       numDirectionalRuns      31       0       6
+       lenDirectionalRuns       2       4       5
+    numIncreasesDecreases       6       0      23
+            numRunsMedian       5       1       9
+            lenRunsMedian       8       3       3
+             avgCollision       6       0      12
+             maxCollision      27       5       1
+           periodicity(1)      13       0       6
+           periodicity(2)       5       1      13
+           periodicity(8)      62       0       6
+          periodicity(16)      24       0       6
+          periodicity(32)      13       0       6
+            covariance(1)      17       0       6
+            covariance(2)      17       0       6
+            covariance(8)       6       0       6
+           covariance(16)      66       0       6
+           covariance(32)      13       0       6
+              compression      11       2       4
+(* denotes failed test)
+
+Chi square tests: Passed
+Length of longest repeated substring test: Passed
+IID permutation tests: Passed
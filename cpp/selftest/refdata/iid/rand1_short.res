@@ -0,0 +1,66 @@
+Opening file: '../../bin/rand1_short.bin' (SHA-256 hash 3814404497a3b912f8d3db6bc05a99338f0986cd75fe54af2a5f1bdb0a12a583), reading block 0 of size 20000
+Loaded 10000 samples of 2 distinct 1-bit-wide symbols
+
+*** Warning: data contains less than 1000000 samples ***
+
+Raw Mean = 0.50080000000000002
+Median = 0.5
+Binary = true
+H_original = 0.96105882570055079
+Assessed min entropy: 0.96105882570055079
+Chi square independence: T = 106.89612714502464
+Chi square independence: df = 126
+Chi square independence: P-value = 0.89022089007981087
+Chi square goodness of fit: T = 10.918427951175554
+Chi square goodness of fit: df = 9
+Chi square goodness of fit: P-value = 0.28134177659941123
+Literal Longest Repeated Substring results: P_col = 0.5000012800000000000962
+Literal Longest Repeated Substring results: W = 25
+Literal Longest Repeated Substring results: Pr(X >= 1) = 0.7730256848028875665282
+Permutation testing: Unpermuted result excursion = 68.69119999999988124273
+Permutation testing: Unpermuted result numDirectionalRuns = 793
+Permutation testing: Unpermuted result lenDirectionalRuns = 7
+Permutation testing: Unpermuted result numIncreasesDecreases = 746
+Permutation testing: Unpermuted result numRunsMedian = 5044
+Permutation testing: Unpermuted result lenRunsMedian = 12
+Permutation testing: Unpermuted result avgCollision = 22.94339622641509279788
+Permutation testing: Unpermuted result maxCollision = 53
+Permutation testing: Unpermuted result periodicity(1) = 222
+Permutation testing: Unpermuted result periodicity(2) = 230
+Permutation testing: Unpermuted result periodicity(8) = 224
+Permutation testing: Unpermuted result periodicity(16) = 224
+Permutation testing: Unpermuted result periodicity(32) = 235
+Permutation testing: Unpermuted result covariance(1) = 20021
+Permutation testing: Unpermuted result covariance(2) = 19982
+Permutation testing: Unpermuted result covariance(8) = 20092
+Permutation testing: Unpermuted result covariance(16) = 19719
+Permutation testing: Unpermuted result covariance(32) = 19526
+Permutation testing: Unpermuted result compression = 1611
+
+
+                statistic  C[i][0]  C[i][1]  C[i][2]
+----------------------------------------------------
+                excursion       6       0     129
+       numDirectionalRuns       5       1       7
+       lenDirectionalRuns       3       4       2
+    numIncreasesDecreases       6       1       5
+            numRunsMedian       6       0      10
+            lenRunsMedian      17       3       3
+             avgCollision       6       0      72
+             maxCollision       5       1      24
+           periodicity(1)      69       2       4
+           periodicity(2)      18       1       5
+           periodicity(8)      84       1       5
+          periodicity(16)      40       0       6
+          periodicity(32)       6       0       6
+            covariance(1)       9       0       6
+            covariance(2)       6       0       6
+            covariance(8)       6       0     131
+           covariance(16)      10       0       6
+           covariance(32)      12       0       6
+              compression       5       3       3
+(* denotes failed test)
+
+Chi square tests: Passed
+Length of longest repeated substring test: Passed
+IID permutation tests: Passed
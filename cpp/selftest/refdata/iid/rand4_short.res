@@ -0,0 +1,69 @@
+Opening file: '../../bin/rand4_short.bin' (SHA-256 hash a9e2169cb1accc78cd23892d793a232b84b0cd13ccc3923526e0b20762bd77ac), reading block 0 of size 20000
+Loaded 10000 samples of 16 distinct 4-bit-wide symbols
+Number of Binary samples: 40000
+
+*** Warning: data contains less than 1000000 samples ***
+
+Raw Mean = 7.5183999999999997
+Median = 8
+Binary = false
+H_bitstring = 0.97918948296240216
+H_bitstring Per Symbol = 3.9167579318496086
+H_original = 3.7900373902139739
+Assessed min entropy: 3.7900373902139739
+Chi square independence: T = 234.34619998315162
+Chi square independence: df = 240
+Chi square independence: P-value = 0.59080606880557762
+Chi square goodness of fit: T = 150.75514709180158
+Chi square goodness of fit: df = 135
+Chi square goodness of fit: P-value = 0.16750195761274278
+Literal Longest Repeated Substring results: P_col = 0.06258266000000000090604
+Literal Longest Repeated Substring results: W = 6
+Literal Longest Repeated Substring results: Pr(X >= 1) = 0.9502456022261927853409
+Permutation testing: Unpermuted result excursion = 450.3760000000005447873
+Permutation testing: Unpermuted result numDirectionalRuns = 6669
+Permutation testing: Unpermuted result lenDirectionalRuns = 7
+Permutation testing: Unpermuted result numIncreasesDecreases = 5269
+Permutation testing: Unpermuted result numRunsMedian = 4990
+Permutation testing: Unpermuted result lenRunsMedian = 13
+Permutation testing: Unpermuted result avgCollision = 5.742102240091901066421
+Permutation testing: Unpermuted result maxCollision = 14
+Permutation testing: Unpermuted result periodicity(1) = 547
+Permutation testing: Unpermuted result periodicity(2) = 604
+Permutation testing: Unpermuted result periodicity(8) = 664
+Permutation testing: Unpermuted result periodicity(16) = 692
+Permutation testing: Unpermuted result periodicity(32) = 598
+Permutation testing: Unpermuted result covariance(1) = 562563
+Permutation testing: Unpermuted result covariance(2) = 562511
+Permutation testing: Unpermuted result covariance(8) = 569110
+Permutation testing: Unpermuted result covariance(16) = 568260
+Permutation testing: Unpermuted result covariance(32) = 561023
+Permutation testing: Unpermuted result compression = 5520
+
+
+                statistic  C[i][0]  C[i][1]  C[i][2]
+----------------------------------------------------
+                excursion       6       0      15
+       numDirectionalRuns       6       0      23
+       lenDirectionalRuns       0       6       0
+    numIncreasesDecreases     123       1       5
+            numRunsMedian       4       2       7
+            lenRunsMedian       3       3       4
+             avgCollision       6       0      24
+             maxCollision       0       6       3
+           periodicity(1)    5907       0       6
+           periodicity(2)      56       0       6
+           periodicity(8)       5       1      45
+          periodicity(16)       6       0    2074
+          periodicity(32)      25       0       6
+            covariance(1)      72       0       6
+            covariance(2)      55       0       6
+            covariance(8)       6       0      87
+           covariance(16)       6       0     173
+           covariance(32)      34       0       6
+              compression       6       0      13
+(* denotes failed test)
+
+Chi square tests: Passed
+Length of longest repeated substring test: Passed
+IID permutation tests: Passed
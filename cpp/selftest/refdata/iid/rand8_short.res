@@ -0,0 +1,69 @@
+Opening file: '../../bin/rand8_short.bin' (SHA-256 hash 17d2eaf9544cd6aea3e245bec362f494376d0b1ca6140c475a35f1ad1f8c2803), reading block 0 of size 20000
+Loaded 10000 samples of 256 distinct 8-bit-wide symbols
+Number of Binary samples: 80000
+
+*** Warning: data contains less than 1000000 samples ***
+
+Raw Mean = 127.648
+Median = 128
+Binary = false
+H_bitstring = 0.9833867846591503
+H_bitstring Per Symbol = 7.8670942772732024
+H_original = 7.0104540377360411
+Assessed min entropy: 7.0104540377360411
+Chi square independence: T = 1026.2423761301056
+Chi square independence: df = 735
+Chi square independence: P-value = 5.5143772576210119e-12
+Chi square goodness of fit: T = 1288.2367907397536
+Chi square goodness of fit: df = 1206
+Chi square goodness of fit: P-value = 0.049333049713476802
+Literal Longest Repeated Substring results: P_col = 0.004008299999999999978388
+Literal Longest Repeated Substring results: W = 3
+Literal Longest Repeated Substring results: Pr(X >= 1) = 0.9599790286591452341276
+Permutation testing: Unpermuted result excursion = 6638.535999999970954377
+Permutation testing: Unpermuted result numDirectionalRuns = 6727
+Permutation testing: Unpermuted result lenDirectionalRuns = 6
+Permutation testing: Unpermuted result numIncreasesDecreases = 5006
+Permutation testing: Unpermuted result numRunsMedian = 4938
+Permutation testing: Unpermuted result lenRunsMedian = 13
+Permutation testing: Unpermuted result avgCollision = 20.30487804878048763157
+Permutation testing: Unpermuted result maxCollision = 67
+Permutation testing: Unpermuted result periodicity(1) = 34
+Permutation testing: Unpermuted result periodicity(2) = 30
+Permutation testing: Unpermuted result periodicity(8) = 49
+Permutation testing: Unpermuted result periodicity(16) = 49
+Permutation testing: Unpermuted result periodicity(32) = 35
+Permutation testing: Unpermuted result covariance(1) = 163045111
+Permutation testing: Unpermuted result covariance(2) = 163784454
+Permutation testing: Unpermuted result covariance(8) = 162563680
+Permutation testing: Unpermuted result covariance(16) = 162531901
+Permutation testing: Unpermuted result covariance(32) = 161376389
+Permutation testing: Unpermuted result compression = 10987
+
+
+                statistic  C[i][0]  C[i][1]  C[i][2]
+----------------------------------------------------
+                excursion       6       0       8
+       numDirectionalRuns       6       0     204
+       lenDirectionalRuns       1       6       0
+    numIncreasesDecreases      30       0       6
+            numRunsMedian      34       0       6
+            lenRunsMedian       6       2       4
+             avgCollision      11       0       6
+             maxCollision       5       1     139
+           periodicity(1)      36       2       4
+           periodicity(2)      87       0       6
+           periodicity(8)       5       1     116
+          periodicity(16)       3       3      90
+          periodicity(32)      26       1       5
+            covariance(1)       6       0      21
+            covariance(2)       6       0     127
+            covariance(8)      11       0       6
+           covariance(16)      21       0       6
+           covariance(32)     124       0       6
+              compression       6       0      92
+(* denotes failed test)
+
+Chi square tests: Failed
+Length of longest repeated substring test: Passed
+IID permutation tests: Passed
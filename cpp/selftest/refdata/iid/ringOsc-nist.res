@@ -0,0 +1,66 @@
+Opening file: '../../bin/ringOsc-nist.bin' (SHA-256 hash 7d37dc3795e9b2927beb779008d7f4b4630dd7f2c058a2b14cee9d41a658dd68), reading block 0 of size 20000
+Loaded 20000 samples of 2 distinct 1-bit-wide symbols
+
+*** Warning: data contains less than 1000000 samples ***
+
+Raw Mean = 0.50819999999999999
+Median = 0.5
+Binary = true
+H_original = 0.9509103521691844
+Assessed min entropy: 0.9509103521691844
+Chi square independence: T = 46959.724908046948
+Chi square independence: df = 254
+Chi square independence: P-value = 0
+Chi square goodness of fit: T = 105.72123478330731
+Chi square goodness of fit: df = 9
+Chi square goodness of fit: P-value = 1.089927703076783e-18
+Literal Longest Repeated Substring results: P_col = 0.5001344799999999994849
+Literal Longest Repeated Substring results: W = 67
+Literal Longest Repeated Substring results: Pr(X >= 1) = 1.370731815813347465038e-12
+Permutation testing: Unpermuted result excursion = 181.9722000000000434738
+Permutation testing: Unpermuted result numDirectionalRuns = 1381
+Permutation testing: Unpermuted result lenDirectionalRuns = 8
+Permutation testing: Unpermuted result numIncreasesDecreases = 1487
+Permutation testing: Unpermuted result numRunsMedian = 3161
+Permutation testing: Unpermuted result lenRunsMedian = 59
+Permutation testing: Unpermuted result avgCollision = 5.649321266968326149538
+Permutation testing: Unpermuted result maxCollision = 15
+Permutation testing: Unpermuted result periodicity(1) = 470
+Permutation testing: Unpermuted result periodicity(2) = 347
+Permutation testing: Unpermuted result periodicity(8) = 294
+Permutation testing: Unpermuted result periodicity(16) = 295
+Permutation testing: Unpermuted result periodicity(32) = 298
+Permutation testing: Unpermuted result covariance(1) = 48891
+Permutation testing: Unpermuted result covariance(2) = 42238
+Permutation testing: Unpermuted result covariance(8) = 41194
+Permutation testing: Unpermuted result covariance(16) = 40048
+Permutation testing: Unpermuted result covariance(32) = 40454
+Permutation testing: Unpermuted result compression = 2257
+
+
+                statistic  C[i][0]  C[i][1]  C[i][2]
+----------------------------------------------------
+               excursion*       0       0   10000
+      numDirectionalRuns*   10000       0       0
+       lenDirectionalRuns       2       4      12
+    numIncreasesDecreases      16       0       6
+           numRunsMedian*   10000       0       0
+           lenRunsMedian*       0       0   10000
+            avgCollision*   10000       0       0
+            maxCollision*   10000       0       0
+           periodicity(1)      16       1       5
+          periodicity(2)*   10000       0       0
+          periodicity(8)*   10000       0       0
+         periodicity(16)*   10000       0       0
+         periodicity(32)*   10000       0       0
+           covariance(1)*       0       0   10000
+           covariance(2)*       0       0   10000
+            covariance(8)      14       0       6
+          covariance(16)*   10000       0       0
+           covariance(32)    3392       0       6
+             compression*   10000       0       0
+(* denotes failed test)
+
+Chi square tests: Failed
+Length of longest repeated substring test: Failed
+IID permutation tests: Failed
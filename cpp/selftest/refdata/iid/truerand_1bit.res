@@ -0,0 +1,66 @@
+Opening file: '../../bin/truerand_1bit.bin' (SHA-256 hash f9ea8832af4c4205f518845b264465800921688fc2c4d566fbc087664aeb2313), reading block 0 of size 20000
+Loaded 20000 samples of 2 distinct 1-bit-wide symbols
+
+*** Warning: data contains less than 1000000 samples ***
+
+Raw Mean = 0.49985000000000002
+Median = 0.5
+Binary = true
+H_original = 0.97353373822193845
+Assessed min entropy: 0.97353373822193845
+Chi square independence: T = 262.73651157338168
+Chi square independence: df = 254
+Chi square independence: P-value = 0.33989003028452719
+Chi square goodness of fit: T = 13.300201197018108
+Chi square goodness of fit: df = 9
+Chi square goodness of fit: P-value = 0.14948628621477875
+Literal Longest Repeated Substring results: P_col = 0.5000000450000000000038
+Literal Longest Repeated Substring results: W = 27
+Literal Longest Repeated Substring results: Pr(X >= 1) = 0.773763313822023037305
+Permutation testing: Unpermuted result excursion = 73.80849999999990984634
+Permutation testing: Unpermuted result numDirectionalRuns = 1599
+Permutation testing: Unpermuted result lenDirectionalRuns = 7
+Permutation testing: Unpermuted result numIncreasesDecreases = 1487
+Permutation testing: Unpermuted result numRunsMedian = 10024
+Permutation testing: Unpermuted result lenRunsMedian = 15
+Permutation testing: Unpermuted result avgCollision = 23.367924528301887932
+Permutation testing: Unpermuted result maxCollision = 54
+Permutation testing: Unpermuted result periodicity(1) = 442
+Permutation testing: Unpermuted result periodicity(2) = 486
+Permutation testing: Unpermuted result periodicity(8) = 477
+Permutation testing: Unpermuted result periodicity(16) = 457
+Permutation testing: Unpermuted result periodicity(32) = 495
+Permutation testing: Unpermuted result covariance(1) = 39964
+Permutation testing: Unpermuted result covariance(2) = 39802
+Permutation testing: Unpermuted result covariance(8) = 40139
+Permutation testing: Unpermuted result covariance(16) = 39603
+Permutation testing: Unpermuted result covariance(32) = 39647
+Permutation testing: Unpermuted result compression = 3173
+
+
+                statistic  C[i][0]  C[i][1]  C[i][2]
+----------------------------------------------------
+                excursion       6       0      10
+       numDirectionalRuns       6       0      14
+       lenDirectionalRuns      14       5       1
+    numIncreasesDecreases      26       0       6
+            numRunsMedian       9       0       6
+            lenRunsMedian       5       1       7
+             avgCollision       6       0    1622
+             maxCollision       6       0       8
+           periodicity(1)     722       2       4
+           periodicity(2)      19       0       6
+           periodicity(8)      14       1       5
+          periodicity(16)      90       0       6
+          periodicity(32)       6       0      13
+            covariance(1)      14       0       6
+            covariance(2)      42       0       6
+            covariance(8)       6       0    2297
+           covariance(16)      37       0       6
+           covariance(32)       6       0     189
+              compression       6       0       7
+(* denotes failed test)
+
+Chi square tests: Passed
+Length of longest repeated substring test: Passed
+IID permutation tests: Passed
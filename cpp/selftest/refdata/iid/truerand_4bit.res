@@ -0,0 +1,69 @@
+Opening file: '../../bin/truerand_4bit.bin' (SHA-256 hash 489bc841bb364ba86da70b1617138aef76b25dd9196ad669eef40c1441b6cb88), reading block 0 of size 20000
+Loaded 20000 samples of 16 distinct 4-bit-wide symbols
+Number of Binary samples: 80000
+
+*** Warning: data contains less than 1000000 samples ***
+
+Raw Mean = 7.5316000000000001
+Median = 8
+Binary = false
+H_bitstring = 0.98484933115888196
+H_bitstring Per Symbol = 3.9393973246355278
+H_original = 3.8331842579831412
+Assessed min entropy: 3.8331842579831412
+Chi square independence: T = 216.94118587225651
+Chi square independence: df = 240
+Chi square independence: P-value = 0.854865639878299
+Chi square goodness of fit: T = 148.71301865188596
+Chi square goodness of fit: df = 135
+Chi square goodness of fit: P-value = 0.19818864889792037
+Literal Longest Repeated Substring results: P_col = 0.06255034000000000086311
+Literal Longest Repeated Substring results: W = 6
+Literal Longest Repeated Substring results: Pr(X >= 1) = 0.9999936817458958491904
+Permutation testing: Unpermuted result excursion = 420.8739999999998531166
+Permutation testing: Unpermuted result numDirectionalRuns = 13286
+Permutation testing: Unpermuted result lenDirectionalRuns = 7
+Permutation testing: Unpermuted result numIncreasesDecreases = 10557
+Permutation testing: Unpermuted result numRunsMedian = 10011
+Permutation testing: Unpermuted result lenRunsMedian = 15
+Permutation testing: Unpermuted result avgCollision = 5.73666092943201366694
+Permutation testing: Unpermuted result maxCollision = 14
+Permutation testing: Unpermuted result periodicity(1) = 1170
+Permutation testing: Unpermuted result periodicity(2) = 1211
+Permutation testing: Unpermuted result periodicity(8) = 1256
+Permutation testing: Unpermuted result periodicity(16) = 1330
+Permutation testing: Unpermuted result periodicity(32) = 1196
+Permutation testing: Unpermuted result covariance(1) = 1130817
+Permutation testing: Unpermuted result covariance(2) = 1130040
+Permutation testing: Unpermuted result covariance(8) = 1135869
+Permutation testing: Unpermuted result covariance(16) = 1135811
+Permutation testing: Unpermuted result covariance(32) = 1131580
+Permutation testing: Unpermuted result compression = 10965
+
+
+                statistic  C[i][0]  C[i][1]  C[i][2]
+----------------------------------------------------
+                excursion      16       0       6
+       numDirectionalRuns       6       0      11
+       lenDirectionalRuns       2       4       2
+    numIncreasesDecreases     152       0       6
+            numRunsMedian       6       0       9
+            lenRunsMedian       9       1       5
+             avgCollision       6       0      10
+             maxCollision       5       4       2
+           periodicity(1)     835       0       6
+           periodicity(2)      31       0       6
+           periodicity(8)       6       0      15
+          periodicity(16)       5       1     495
+          periodicity(32)      64       0       6
+            covariance(1)      46       0       6
+            covariance(2)      60       0       6
+            covariance(8)       6       0      19
+           covariance(16)       6       0      17
+           covariance(32)      22       0       6
+              compression       5       1      81
+(* denotes failed test)
+
+Chi square tests: Passed
+Length of longest repeated substring test: Passed
+IID permutation tests: Passed
@@ -0,0 +1,69 @@
+Opening file: '../../bin/truerand_8bit.bin' (SHA-256 hash c7e56911d2657fa9b6e86c03d4477474d6ec698691c5f32d3918ec513713e3c3), reading block 0 of size 20000
+Loaded 20000 samples of 256 distinct 8-bit-wide symbols
+Number of Binary samples: 160000
+
+*** Warning: data contains less than 1000000 samples ***
+
+Raw Mean = 127.95515
+Median = 128
+Binary = false
+H_bitstring = 0.99063191008352314
+H_bitstring Per Symbol = 7.9250552806681851
+H_original = 7.1785262183067164
+Assessed min entropy: 7.1785262183067164
+Chi square independence: T = 1992.1581303487276
+Chi square independence: df = 1711
+Chi square independence: P-value = 2.3589882312797309e-06
+Chi square goodness of fit: T = 2274.7759230159768
+Chi square goodness of fit: df = 2295
+Chi square goodness of fit: P-value = 0.61391827149218114
+Literal Longest Repeated Substring results: P_col = 0.003963785000000000011145
+Literal Longest Repeated Substring results: W = 3
+Literal Longest Repeated Substring results: Pr(X >= 1) = 0.9999960915155570142154
+Permutation testing: Unpermuted result excursion = 8944.311050000023897155
+Permutation testing: Unpermuted result numDirectionalRuns = 13415
+Permutation testing: Unpermuted result lenDirectionalRuns = 7
+Permutation testing: Unpermuted result numIncreasesDecreases = 10059
+Permutation testing: Unpermuted result numRunsMedian = 9895
+Permutation testing: Unpermuted result lenRunsMedian = 13
+Permutation testing: Unpermuted result avgCollision = 20.25557809330628700195
+Permutation testing: Unpermuted result maxCollision = 67
+Permutation testing: Unpermuted result periodicity(1) = 70
+Permutation testing: Unpermuted result periodicity(2) = 72
+Permutation testing: Unpermuted result periodicity(8) = 95
+Permutation testing: Unpermuted result periodicity(16) = 79
+Permutation testing: Unpermuted result periodicity(32) = 77
+Permutation testing: Unpermuted result covariance(1) = 328301196
+Permutation testing: Unpermuted result covariance(2) = 329146771
+Permutation testing: Unpermuted result covariance(8) = 327837711
+Permutation testing: Unpermuted result covariance(16) = 326625695
+Permutation testing: Unpermuted result covariance(32) = 326321242
+Permutation testing: Unpermuted result compression = 21536
+
+
+                statistic  C[i][0]  C[i][1]  C[i][2]
+----------------------------------------------------
+                excursion       6       0       9
+       numDirectionalRuns       6       0      29
+       lenDirectionalRuns       1       5       6
+    numIncreasesDecreases       6       0       9
+            numRunsMedian      57       1       5
+            lenRunsMedian      22       3       3
+             avgCollision      65       0       6
+             maxCollision       6       0      29
+           periodicity(1)      31       1       5
+           periodicity(2)       5       2       4
+           periodicity(8)       4       2     241
+          periodicity(16)       6       0      14
+          periodicity(32)       6       2       4
+            covariance(1)       6       0      41
+            covariance(2)       6       0     308
+            covariance(8)       6       0      16
+           covariance(16)      24       0       6
+           covariance(32)      11       0       6
+              compression       6       0      11
+(* denotes failed test)
+
+Chi square tests: Failed
+Length of longest repeated substring test: Passed
+IID permutation tests: Passed
@@ -0,0 +1,7 @@
+Opening file: '../../bin/biased-random-bits.bin' (SHA-256 hash 481cdac6e2d65d45656c21234125eaf26df18a49037f15ffd40002b35e547586)
+Loaded 1000000 samples made up of 2 distinct 1-bit-wide symbols.
+H_I: 0.500000
+ALPHA: 5.0251553006530614e-06, X_cutoff: 768
+X_max: 992
+
+*** Restart Sanity Check Failed ***
@@ -0,0 +1,7 @@
+Opening file: '../../bin/biased-random-bytes.bin' (SHA-256 hash 146bd7497d8e2d61a6e8559c9342ee79f6005a390ee4d776ba43500d00eb508d)
+Loaded 1000000 samples made up of 256 distinct 8-bit-wide symbols.
+H_I: 0.500000
+ALPHA: 5.0251553006530614e-06, X_cutoff: 768
+X_max: 848
+
+*** Restart Sanity Check Failed ***
@@ -0,0 +1,41 @@
+Opening file: '../../bin/normal.bin' (SHA-256 hash a70ce92a71b9b0c6dee80335ef570dea618631ee64cc735b033e9f402f14bc7d)
+Loaded 1000000 samples made up of 179 distinct 8-bit-wide symbols.
+
+Symbols have been translated.
+
+H_I: 0.500000
+ALPHA: 5.0251553006530614e-06, X_cutoff: 768
+X_max: 40
+
+Restart Sanity Check Passed...
+
+Running non-IID tests...
+
+Running Most Common Value Estimate...
+	Most Common Value Estimate (Rows) = 5.622155 / 8 bit(s)
+	Most Common Value Estimate (Cols) = 5.622155 / 8 bit(s)
+
+Running Tuple Estimates...
+	T-Tuple Test Estimate (Rows) = 5.529118 / 8 bit(s)
+	T-Tuple Test Estimate (Cols) = 5.549937 / 8 bit(s)
+	LRS Test Estimate (Rows) = 6.105039 / 8 bit(s)
+	LRS Test Estimate (Cols) = 6.118168 / 8 bit(s)
+
+Running Predictor Estimates...
+	Multi Most Common in Window (MultiMCW) Prediction Test Estimate (Rows) = 5.668174 / 8 bit(s)
+	Multi Most Common in Window (MultiMCW) Prediction Test Estimate (Cols) = 5.673440 / 8 bit(s)
+	Lag Prediction Test Estimate (Rows) = 6.106223 / 8 bit(s)
+	Lag Prediction Test Estimate (Cols) = 6.126351 / 8 bit(s)
+	Multi Markov Model with Counting (MultiMMC) Prediction Test Estimate (Rows) = 5.675758 / 8 bit(s)
+	Multi Markov Model with Counting (MultiMMC) Prediction Test Estimate (Cols) = 5.680006 / 8 bit(s)
+	LZ78Y Prediction Test Estimate (Rows) = 5.679164 / 8 bit(s)
+	LZ78Y Prediction Test Estimate (Cols) = 5.683796 / 8 bit(s)
+
+H_r: 5.529118
+H_c: 5.549937
+H_I: 0.500000
+
+Validation Test Passed...
+
+min(H_r, H_c, H_I): 0.500000
+
@@ -0,0 +1,43 @@
+Opening file: '../../bin/ringOsc-nist.bin' (SHA-256 hash 7d37dc3795e9b2927beb779008d7f4b4630dd7f2c058a2b14cee9d41a658dd68)
+Loaded 1000000 samples made up of 2 distinct 1-bit-wide symbols.
+H_I: 0.500000
+ALPHA: 5.0251553006530614e-06, X_cutoff: 768
+X_max: 647
+
+Restart Sanity Check Passed...
+
+Running non-IID tests...
+
+Running Most Common Value Estimate...
+	Most Common Value Estimate (Rows) = 0.993514 / 1 bit(s)
+	Most Common Value Estimate (Cols) = 0.993514 / 1 bit(s)
+
+Running Entropic Statistic Estimates (bit strings only)...
+	Collision Test Estimate (Rows) = 0.126446 / 1 bit(s)
+	Collision Test Estimate (Cols) = 0.934087 / 1 bit(s)
+	Markov Test Estimate (Rows) = 0.257979 / 1 bit(s)
+	Markov Test Estimate (Cols) = 0.997500 / 1 bit(s)
+	Compression Test Estimate (Rows) = 0.159323 / 1 bit(s)
+	Compression Test Estimate (Cols) = 0.820825 / 1 bit(s)
+
+Running Tuple Estimates...
+	T-Tuple Test Estimate (Rows) = 0.201709 / 1 bit(s)
+	T-Tuple Test Estimate (Cols) = 0.914226 / 1 bit(s)
+	LRS Test Estimate (Rows) = 0.365799 / 1 bit(s)
+	LRS Test Estimate (Cols) = 0.508237 / 1 bit(s)
+
+Running Predictor Estimates...
+	Multi Most Common in Window (MultiMCW) Prediction Test Estimate (Rows) = 0.290519 / 1 bit(s)
+	Multi Most Common in Window (MultiMCW) Prediction Test Estimate (Cols) = 0.973430 / 1 bit(s)
+	Lag Prediction Test Estimate (Rows) = 0.251067 / 1 bit(s)
+	Lag Prediction Test Estimate (Cols) = 0.991300 / 1 bit(s)
+	Multi Markov Model with Counting (MultiMMC) Prediction Test Estimate (Rows) = 0.251069 / 1 bit(s)
+	Multi Markov Model with Counting (MultiMMC) Prediction Test Estimate (Cols) = 0.982717 / 1 bit(s)
+	LZ78Y Prediction Test Estimate (Rows) = 0.251073 / 1 bit(s)
+	LZ78Y Prediction Test Estimate (Cols) = 0.995211 / 1 bit(s)
+
+H_r: 0.126446
+H_c: 0.508237
+H_I: 0.500000
+
+*** min(H_r, H_c) < H_I/2, Validation Testing Failed ***
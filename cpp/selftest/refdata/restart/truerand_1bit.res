@@ -0,0 +1,46 @@
+Opening file: '../../bin/truerand_1bit.bin' (SHA-256 hash f9ea8832af4c4205f518845b264465800921688fc2c4d566fbc087664aeb2313)
+Loaded 1000000 samples made up of 2 distinct 1-bit-wide symbols.
+H_I: 0.500000
+ALPHA: 5.0251553006530614e-06, X_cutoff: 768
+X_max: 556
+
+Restart Sanity Check Passed...
+
+Running non-IID tests...
+
+Running Most Common Value Estimate...
+	Most Common Value Estimate (Rows) = 0.995043 / 1 bit(s)
+	Most Common Value Estimate (Cols) = 0.995043 / 1 bit(s)
+
+Running Entropic Statistic Estimates (bit strings only)...
+	Collision Test Estimate (Rows) = 0.900936 / 1 bit(s)
+	Collision Test Estimate (Cols) = 0.901696 / 1 bit(s)
+	Markov Test Estimate (Rows) = 0.998486 / 1 bit(s)
+	Markov Test Estimate (Cols) = 0.997424 / 1 bit(s)
+	Compression Test Estimate (Rows) = 0.829677 / 1 bit(s)
+	Compression Test Estimate (Cols) = 0.849668 / 1 bit(s)
+
+Running Tuple Estimates...
+	T-Tuple Test Estimate (Rows) = 0.914226 / 1 bit(s)
+	T-Tuple Test Estimate (Cols) = 0.938052 / 1 bit(s)
+	LRS Test Estimate (Rows) = 0.985818 / 1 bit(s)
+	LRS Test Estimate (Cols) = 0.898042 / 1 bit(s)
+
+Running Predictor Estimates...
+	Multi Most Common in Window (MultiMCW) Prediction Test Estimate (Rows) = 0.996972 / 1 bit(s)
+	Multi Most Common in Window (MultiMCW) Prediction Test Estimate (Cols) = 0.996221 / 1 bit(s)
+	Lag Prediction Test Estimate (Rows) = 0.998292 / 1 bit(s)
+	Lag Prediction Test Estimate (Cols) = 0.994329 / 1 bit(s)
+	Multi Markov Model with Counting (MultiMMC) Prediction Test Estimate (Rows) = 0.996660 / 1 bit(s)
+	Multi Markov Model with Counting (MultiMMC) Prediction Test Estimate (Cols) = 0.994931 / 1 bit(s)
+	LZ78Y Prediction Test Estimate (Rows) = 0.997050 / 1 bit(s)
+	LZ78Y Prediction Test Estimate (Cols) = 0.996250 / 1 bit(s)
+
+H_r: 0.829677
+H_c: 0.849668
+H_I: 0.500000
+
+Validation Test Passed...
+
+min(H_r, H_c, H_I): 0.500000
+
@@ -0,0 +1,38 @@
+Opening file: '../../bin/truerand_4bit.bin' (SHA-256 hash 489bc841bb364ba86da70b1617138aef76b25dd9196ad669eef40c1441b6cb88)
+Loaded 1000000 samples made up of 16 distinct 4-bit-wide symbols.
+H_I: 0.500000
+ALPHA: 5.0251553006530614e-06, X_cutoff: 768
+X_max: 96
+
+Restart Sanity Check Passed...
+
+Running non-IID tests...
+
+Running Most Common Value Estimate...
+	Most Common Value Estimate (Rows) = 3.971194 / 4 bit(s)
+	Most Common Value Estimate (Cols) = 3.971194 / 4 bit(s)
+
+Running Tuple Estimates...
+	T-Tuple Test Estimate (Rows) = 3.687754 / 4 bit(s)
+	T-Tuple Test Estimate (Cols) = 3.883929 / 4 bit(s)
+	LRS Test Estimate (Rows) = 3.934966 / 4 bit(s)
+	LRS Test Estimate (Cols) = 3.919766 / 4 bit(s)
+
+Running Predictor Estimates...
+	Multi Most Common in Window (MultiMCW) Prediction Test Estimate (Rows) = 3.992285 / 4 bit(s)
+	Multi Most Common in Window (MultiMCW) Prediction Test Estimate (Cols) = 3.984578 / 4 bit(s)
+	Lag Prediction Test Estimate (Rows) = 3.976271 / 4 bit(s)
+	Lag Prediction Test Estimate (Cols) = 3.987377 / 4 bit(s)
+	Multi Markov Model with Counting (MultiMMC) Prediction Test Estimate (Rows) = 3.985263 / 4 bit(s)
+	Multi Markov Model with Counting (MultiMMC) Prediction Test Estimate (Cols) = 3.985354 / 4 bit(s)
+	LZ78Y Prediction Test Estimate (Rows) = 3.984277 / 4 bit(s)
+	LZ78Y Prediction Test Estimate (Cols) = 3.981756 / 4 bit(s)
+
+H_r: 3.687754
+H_c: 3.883929
+H_I: 0.500000
+
+Validation Test Passed...
+
+min(H_r, H_c, H_I): 0.500000
+
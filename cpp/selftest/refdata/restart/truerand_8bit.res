@@ -0,0 +1,38 @@
+Opening file: '../../bin/truerand_8bit.bin' (SHA-256 hash c7e56911d2657fa9b6e86c03d4477474d6ec698691c5f32d3918ec513713e3c3)
+Loaded 1000000 samples made up of 256 distinct 8-bit-wide symbols.
+H_I: 0.500000
+ALPHA: 5.0251553006530614e-06, X_cutoff: 768
+X_max: 16
+
+Restart Sanity Check Passed...
+
+Running non-IID tests...
+
+Running Most Common Value Estimate...
+	Most Common Value Estimate (Rows) = 7.865118 / 8 bit(s)
+	Most Common Value Estimate (Cols) = 7.865118 / 8 bit(s)
+
+Running Tuple Estimates...
+	T-Tuple Test Estimate (Rows) = 7.865118 / 8 bit(s)
+	T-Tuple Test Estimate (Cols) = 7.353758 / 8 bit(s)
+	LRS Test Estimate (Rows) = 7.939199 / 8 bit(s)
+	LRS Test Estimate (Cols) = 7.945007 / 8 bit(s)
+
+Running Predictor Estimates...
+	Multi Most Common in Window (MultiMCW) Prediction Test Estimate (Rows) = 7.988580 / 8 bit(s)
+	Multi Most Common in Window (MultiMCW) Prediction Test Estimate (Cols) = 7.919931 / 8 bit(s)
+	Lag Prediction Test Estimate (Rows) = 7.939765 / 8 bit(s)
+	Lag Prediction Test Estimate (Cols) = 6.638405 / 8 bit(s)
+	Multi Markov Model with Counting (MultiMMC) Prediction Test Estimate (Rows) = 7.926809 / 8 bit(s)
+	Multi Markov Model with Counting (MultiMMC) Prediction Test Estimate (Cols) = 7.968241 / 8 bit(s)
+	LZ78Y Prediction Test Estimate (Rows) = 7.926787 / 8 bit(s)
+	LZ78Y Prediction Test Estimate (Cols) = 7.969695 / 8 bit(s)
+
+H_r: 7.865118
+H_c: 6.638405
+H_I: 0.500000
+
+Validation Test Passed...
+
+min(H_r, H_c, H_I): 0.500000
+
@@ -7,6 +7,8 @@
 #include <openssl/evp.h>
 #include <openssl/sha.h>
 
+#include "timing.h"
+
 using namespace std;
 
 string getCurrentTimestamp() {
@@ -59,7 +61,7 @@ void sha256_hash_string(unsigned char *hash, char *outputBuffer) {
     }
 }
 
-int sha256_file(const char *path, char *outputBuffer) {
+int sha256_file(const char *path, char *outputBuffer, PhaseTimings *phases = NULL) {
     unsigned char *buffer=NULL;
     unsigned char digest[SHA256_DIGEST_LENGTH];
     size_t bytesRead;
@@ -67,6 +69,7 @@ int sha256_file(const char *path, char *outputBuffer) {
     const int bufSize = 32768;
     int res = 0;
     EVP_MD_CTX *mdctx = NULL;
+    PhaseTimer hashTimer("Hash", phases);
 
     // open the file
     if((file = fopen(path, "rb"))==NULL) {
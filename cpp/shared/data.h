@@ -0,0 +1,23 @@
+//Version of the tool
+#define VERSION "1.1.8"
+
+#pragma once
+#include <stdint.h>
+
+//This header holds only declarations, so (unlike utils.h) it may be included by programs that link with libentropyassessment
+
+#define MIN_SIZE 1000000
+#define PERMS 10000
+
+typedef struct data_t data_t;
+
+struct data_t{
+	int word_size; 		// bits per symbol
+	int alph_size; 		// symbol alphabet size
+	uint8_t maxsymbol; 	// the largest symbol present in the raw data stream
+	uint8_t *rawsymbols; 	// raw data words
+	uint8_t *symbols; 		// data words
+	uint8_t *bsymbols; 	// data words as binary string
+	long len; 		// number of words in data
+	long blen; 		// number of bits in data
+};
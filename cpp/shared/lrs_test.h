@@ -2,54 +2,99 @@
 
 #include "utils.h"
 #include <climits>
+#include <atomic>
 #include <divsufsort.h>
 #include <divsufsort64.h>
 
 #define SAINDEX_MAX INT32_MAX
+#define SAINDEX40_MAX 0xFFFFFFFFFFLL
 #define SAINDEX64_MAX INT64_MAX
 
-//Using the Kasai (et al.) O(n) time "13n space" algorithm.
-//"Linear-Time Longest-Common-Prefix Computation in Suffix Arrays and Its Applications", by Kasai, Lee, Arimura, Arikawa, and Park
-//https://doi.org/10.1007/3-540-48194-X_17
-//http://web.cs.iastate.edu/~cs548/references/linear_lcp.pdf
-//The default implementation uses 4 byte indexes
-static void sa2lcp32(const uint8_t text[], long int n, const vector<saidx_t> &sa, vector<saidx_t> &lcp) {
-	saidx_t h;
-	vector<saidx_t> rank(n+1,-1);
+//Inputs with fewer than SAINDEX_MAX symbols use 4 byte indexes. Longer inputs use 5 byte packed indexes
+//(which cuts the SA/LCP/rank memory use by 3/8 relative to 8 byte indexes) up to SAINDEX40_MAX symbols,
+//and 8 byte indexes beyond that. Build with -DNO_SAINDEX40 to always use 8 byte indexes for long inputs.
+#ifndef NO_SAINDEX40
+//A 40-bit index, stored in 5 bytes. All the stored values are non-negative other than the -1 sentinel,
+//which is represented as 0xFFFFFFFFFF.
+struct saidx40_t {
+	uint8_t b[5];
+
+	saidx40_t() {}
+	saidx40_t(saidx64_t x) {
+		*this = x;
+	}
 
-	assert(n>1);
+	saidx40_t &operator=(saidx64_t x) {
+		uint64_t ux = (uint64_t)x;
 
-	lcp[0] = -1;
-	lcp[1] = 0;
+		assert((x >= -1) && (x < SAINDEX40_MAX));
+		memcpy(b, &ux, 5);
+		return *this;
+	}
 
-	// compute rank = sa^{-1}
-	for(saidx_t i=0; i<=(saidx_t)n; i++) {
-		rank[sa[i]] = i;
+	operator saidx64_t() const {
+		uint64_t ux = 0;
+
+		memcpy(&ux, b, 5);
+		return (ux == (uint64_t)SAINDEX40_MAX) ? -1 : (saidx64_t)ux;
 	}
+};
+#endif
 
-	// traverse suffixes in rank order
-	h=0;
+//The properties of each index type: the arithmetic type used for values read from the SA/LCP arrays,
+//the (unsigned) type used for the LRS numerators, and the divsufsort backend.
+template <typename saidx_type> struct SAIndexTraits;
 
-	for(saidx_t i=0; i<(saidx_t)n; i++) {
-		saidx_t k = rank[i]; // rank of s[i ... n-1]
-		if(k>1) {
-			saidx_t j = sa[k-1]; // predecessor of s[i ... n-1]
-			while((i+h<(saidx_t)n) && (j+h<(saidx_t)n) && (text[i+h]==text[j+h])) {
-				h++;
-			}
+template <> struct SAIndexTraits<saidx_t> {
+	typedef saidx_t value_type;
+	typedef uint64_t sum_type;
+	static const long int max = SAINDEX_MAX;
 
-			lcp[k] = h;
-		}
-		if(h>0) {
-			h--;
-		}
+	static int suffixsort(const uint8_t text[], saidx_t *sa, long int n) {
+		return divsufsort((const sauchar_t *)text, sa, (saidx_t)n);
 	}
-}
+};
+
+#ifndef NO_SAINDEX40
+template <> struct SAIndexTraits<saidx40_t> {
+	typedef saidx64_t value_type;
+	typedef uint128_t sum_type;
+	static const long int max = SAINDEX40_MAX;
+
+	//divsufsort64 produces 8 byte indexes, which are then packed.
+	static int suffixsort(const uint8_t text[], saidx40_t *sa, long int n) {
+		vector<saidx64_t> sa64(n);
+		int res;
+
+		res = divsufsort64((const sauchar_t *)text, sa64.data(), (saidx64_t)n);
+		for(long int i=0; i<n; i++) sa[i] = sa64[i];
+
+		return res;
+	}
+};
+#endif
+
+template <> struct SAIndexTraits<saidx64_t> {
+	typedef saidx64_t value_type;
+	typedef uint128_t sum_type;
+	static const long int max = SAINDEX64_MAX;
+
+	static int suffixsort(const uint8_t text[], saidx64_t *sa, long int n) {
+		return divsufsort64((const sauchar_t *)text, sa, (saidx64_t)n);
+	}
+};
 
-//Using the Kasai (et al.) O(n) time "25n space" algorithm (with 64-bit indicies)
-static void sa2lcp64(const uint8_t text[], long int n, const vector<saidx64_t> &sa, vector<saidx64_t> &lcp) {
-	saidx64_t h;
-	vector<saidx64_t> rank(n+1,-1);
+//Using the Kasai (et al.) O(n) time "13n space" algorithm (with 4 byte indexes; "25n space" with 8 byte indexes).
+//"Linear-Time Longest-Common-Prefix Computation in Suffix Arrays and Its Applications", by Kasai, Lee, Arimura, Arikawa, and Park
+//https://doi.org/10.1007/3-540-48194-X_17
+//http://web.cs.iastate.edu/~cs548/references/linear_lcp.pdf
+//Returns the largest LCP value (that is, the length of the LRS)
+template <typename saidx_type>
+static typename SAIndexTraits<saidx_type>::value_type sa2lcp(const uint8_t text[], long int n, const vector<saidx_type> &sa, vector<saidx_type> &lcp) {
+	typedef typename SAIndexTraits<saidx_type>::value_type idx_t;
+	idx_t h;
+	idx_t maxlcp = 0;
+	vector<saidx_type> rank(n+1, -1);
 
 	assert(n>1);
 
@@ -57,119 +102,117 @@ static void sa2lcp64(const uint8_t text[], long int n, const vector<saidx64_t> &
 	lcp[1] = 0;
 
 	// compute rank = sa^{-1}
-	for(saidx64_t i=0; i<=(saidx64_t)n; i++) {
-		rank[sa[i]] = i;
+	for(idx_t i=0; i<=(idx_t)n; i++) {
+		rank[(idx_t)sa[i]] = i;
 	}
 
 	// traverse suffixes in rank order
 	h=0;
 
-	for(saidx64_t i=0; i<(saidx64_t)n; i++) {
-		saidx64_t k = rank[i]; // rank of s[i ... n-1]
+	for(idx_t i=0; i<(idx_t)n; i++) {
+		idx_t k = rank[i]; // rank of s[i ... n-1]
 		if(k>1) {
-			saidx64_t j = sa[k-1]; // predecessor of s[i ... n-1]
-			while((i+h<(saidx64_t)n) && (j+h<(saidx64_t)n) && (text[i+h]==text[j+h])) {
+			idx_t j = sa[k-1]; // predecessor of s[i ... n-1]
+			while((i+h<(idx_t)n) && (j+h<(idx_t)n) && (text[i+h]==text[j+h])) {
 				h++;
 			}
 
 			lcp[k] = h;
+			if(h > maxlcp) maxlcp = h;
 		}
 		if(h>0) {
 			h--;
 		}
 	}
-}
 
-
-void calcSALCP32(const uint8_t text[], long int n, vector<saidx_t> &sa, vector<saidx_t> &lcp) {
-	int32_t res;
-
-	assert(n < SAINDEX_MAX);
-	assert(n > 0); 
-	assert(sa.size() == (size_t)(n+1));
-	assert(sa.size() == (size_t)(n+1));
-
-	sa[0] = (saidx_t)n;
-
-	res=divsufsort((const sauchar_t *)text, (saidx_t *)(sa.data()+1), (saidx_t)n);
-	assert(res==0);
-   	sa2lcp32(text, n, sa, lcp);
+	return maxlcp;
 }
 
-void calcSALCP64(const uint8_t text[], long int n, vector<saidx64_t> &sa, vector<saidx64_t> &lcp) {
+//Returns the largest LCP value (that is, the length of the LRS)
+//The lcp array (n+2 entries) is only allocated once the suffix sort (and any temporary that it uses) is done, which
+//keeps the peak memory use down to that of the larger of the two steps.
+template <typename saidx_type>
+typename SAIndexTraits<saidx_type>::value_type calcSALCP(const uint8_t text[], long int n, vector<saidx_type> &sa, vector<saidx_type> &lcp) {
 	int32_t res;
 
-	assert(n < SAINDEX64_MAX);
+	assert(n < SAIndexTraits<saidx_type>::max);
 	assert(n > 0);
 	assert(sa.size() == (size_t)(n+1));
-	assert(sa.size() == (size_t)(n+1));
 
-	sa[0] = (saidx64_t)n;
+	sa[0] = n;
 
-	res=divsufsort64((const sauchar_t *)text, (saidx64_t *)(sa.data()+1), (saidx64_t)n);
+	res=SAIndexTraits<saidx_type>::suffixsort(text, sa.data()+1, n);
 	assert(res==0);
-   	sa2lcp64(text, n, sa, lcp);
+
+	lcp.assign(n+2, -1);
+   	return sa2lcp(text, n, sa, lcp);
 }
+
 /* Based on the algorithm outlined by Aaron Kaufer
  * This is described here:
  * http://www.untruth.org/~josh/sp80090b/Kaufer%20Further%20Improvements%20for%20SP%20800-90B%20Tuple%20Counts.pdf
  */
-void SAalgs32(const uint8_t text[], long int n, int k, double &t_tuple_res, double &lrs_res, const int verbose, const char *label) {
-	vector <saidx_t> sa(n+1, -1); //each value is at most n-1
-	vector <saidx_t> L(n+2, -1); //each value is at most n-1
+template <typename saidx_type>
+void SAalgsIndexed(const uint8_t text[], long int n, int k, double &t_tuple_res, double &lrs_res, const int verbose, const char *label, PhaseTimings *phases) {
+	typedef typename SAIndexTraits<saidx_type>::value_type idx_t;
+	typedef typename SAIndexTraits<saidx_type>::sum_type sum_t;
+
+	vector <saidx_type> sa(n+1, -1); //each value is at most n-1
+	vector <saidx_type> lcp; //each value is at most n-1 (allocated by calcSALCP)
+	saidx_type *L; //The LCP array, using Kaufer's conventions
 
    	long int u; //The length of a string: 1 <= u <= v+1 <= n
    	long int v; //The length of the LRS. 1 <= v <= n-1
 	long int c; //contains a count from A
 	long int j; //0 <= j <= v+1 <= n
-	saidx_t t; //Takes values from LCP array. 0 <= t < n
+	idx_t t; //Takes values from LCP array. 0 <= t < n
 
 	long double Pmax;
 	long double pu;
 
 	assert(n>0);
 	assert(k>0);
-	assert(n < SAINDEX_MAX);
-	assert((UINT64_MAX / (uint64_t)n) >= ((uint64_t)n+1U)); // (mult assert)
+	assert(n < SAIndexTraits<saidx_type>::max);
+	assert((((sum_t)~(sum_t)0) / (sum_t)n) >= ((sum_t)n+1U)); // (mult assert)
 
-	calcSALCP32(text, n, sa, L);
+	//The length of the LRS, v, is the largest LCP value, which is found while the LCP array is constructed.
+	PhaseTimer saTimer(string("Suffix array build (") + label + ")", phases);
+	v = calcSALCP(text, n, sa, lcp);
+	saTimer.Stop();
 
-	//to conform with Kaufer's conventions
-	L.erase(L.begin());
+	//to conform with Kaufer's conventions (L[i] = lcp[i+1]).
+	//This offset view avoids moving the whole LCP array.
+	L = lcp.data() + 1;
 	L[n] = 0;
 	assert(L[0] == 0);
 
-	//Find the length of the LRS, v
-
-	v=0;
-	for(long int i=0; i<n; i++) {
-		if(L[i]>v) v = L[i];
-	}
-
 	assert((v>0) && (v < n));
 	//v is now set correctly
 
-	vector <saidx_t> Q(v+1, 1); //Contains an accumulation of positive counts 1 <= Q[i] <= n
-	vector <saidx_t> A(v+2, 0); //Contains an accumulation of positive counts 0 <= A[i] <= n
+	vector <idx_t> Q(v+1, 1); //Contains an accumulation of positive counts 1 <= Q[i] <= n
+	vector <idx_t> A(v+2, 0); //Contains an accumulation of positive counts 0 <= A[i] <= n
 	//I is set from L
 	//Note that I is indexed by at most j+1.
 	// j takes the value 0 to v+1  (so I[v+2] should work)
 	//(I stores indices of A, and there are only v+2 of these)
-	vector <saidx_t> I(v+3, 0); //each value is most 0 <= I[i] <= v+2 <= n+1
+	vector <idx_t> I(v+3, 0); //each value is most 0 <= I[i] <= v+2 <= n+1
 
 	j = 0;
 	for(long int i = 1; i <= n; i++) {
+		const idx_t Lcur = L[i];
+		const idx_t Lprev = L[i-1];
+
 		c = 0;
 		//Note L[0] is already verified to be 0
-		assert(L[i] >= 0);
+		assert(Lcur >= 0);
 
-		if(L[i] < L[i-1]) {
-			t = L[i-1];
+		if(Lcur < Lprev) {
+			t = Lprev;
 			assert(j>0);
 			j--;
 			assert(j<=v);
 
-			while(t > L[i]) {
+			while(t > Lcur) {
 				assert((t>0) && (t <= v));
 				if((j > 0) && (I[j] == t)) {
 					/* update count for non-zero entry of A */
@@ -193,7 +236,7 @@ void SAalgs32(const uint8_t text[], long int n, int k, double &t_tuple_res, doub
 						 * no more non-zero entries of A,
 						 * so skip to L[i] (terminate while loop)
 						 */
-						t = L[i];
+						t = Lcur;
 					}
 				} else {
 					/* update Q[t] with new maximum count */
@@ -205,11 +248,11 @@ void SAalgs32(const uint8_t text[], long int n, int k, double &t_tuple_res, doub
 			A[I[j+1]] = 0;
 		}
 
-		if(L[i] > 0) {
-			if((j < 1) || (I[j] < L[i])) {
+		if(Lcur > 0) {
+			if((j < 1) || (I[j] < Lcur)) {
 				/* insert index of next non-zero entry of A */
 				assert(j<v);
-				I[++j] = L[i];
+				I[++j] = Lcur;
 			}
 			A[I[j]] += c+1; /* update count for t = I[j] = L[i] */
 		}
@@ -260,19 +303,22 @@ void SAalgs32(const uint8_t text[], long int n, int k, double &t_tuple_res, doub
 
 	//calculate the LRS estimate
 	if(v>=u) {
-		vector <uint64_t> S(v+1, 0);
-		memset(A.data(), 0, sizeof(saidx_t)*((size_t)v+2));
+		vector <sum_t> S(v+1, 0);
+		memset(A.data(), 0, sizeof(idx_t)*((size_t)v+2));
 
 		for(long int i = 1; i <= n; i++) {
-			if((L[i-1] >= u) && (L[i] < L[i-1])) {
-				saidx_t b = L[i];
+			const idx_t Lcur = L[i];
+			const idx_t Lprev = L[i-1];
+
+			if((Lprev >= u) && (Lcur < Lprev)) {
+				idx_t b = Lcur;
 
 				//A[u] stores the number of u-length tuples. We need to eventually clear down to A[u]=A[b+1].
 				if(b < u) b = u-1;
 
-				for(t = L[i-1]; t > b; t--) {
-					uint64_t priorS;
-					uint64_t choices;
+				for(t = Lprev; t > b; t--) {
+					sum_t priorS;
+					sum_t choices;
 					A[t] += A[t+1];
 					A[t+1] = 0;
 
@@ -281,11 +327,11 @@ void SAalgs32(const uint8_t text[], long int n, int k, double &t_tuple_res, doub
 					// Note that (c choose 2) is just (c)(c-1)/2.
 					// The numerator of this expression is necessarily even
 					// Dividing an even quantity by 2 is the same as right shifting by 1.
-					// Check for overflows when adding to S[t] (unsigned 64 bit integers)
+					// Check for overflows when adding to S[t] (unsigned 64 or 128 bit integers)
 					// Note, A[t] <= n, so the assert marked "(mult assert)" tells us that the multiplication won't rollover.
 
 					priorS = S[t];
-					choices = ((((uint64_t)(A[t]+1) * (uint64_t)(A[t]))))>>1;
+					choices = ((((sum_t)(A[t]+1) * (sum_t)(A[t]))))>>1;
 					S[t] = priorS + choices;
 					assert(S[t] >= priorS);
 				}
@@ -294,16 +340,16 @@ void SAalgs32(const uint8_t text[], long int n, int k, double &t_tuple_res, doub
 				A[b+1] = 0;
 			}
 
-			if(L[i] >= u) A[L[i]]++; /* update count for t = L[i] */
+			if(Lcur >= u) A[Lcur]++; /* update count for t = L[i] */
 		}
 
 		//We now have a complete set of numerators in S
 		Pmax = 0.0;
 		for(long int i=u; i<=v; i++) {
 			// Note, the assert marked "(mult assert)" tells us that the multiplication won't rollover.
-			uint64_t choices = (((uint64_t)n-(uint64_t)i)*((uint64_t)n-(uint64_t)i+1U))>>1;
+			sum_t choices = (((sum_t)n-(sum_t)i)*((sum_t)n-(sum_t)i+1U))>>1;
 			long double curP = ((long double)S[i]) / (long double)choices;
-			long double curPMax = pow(curP, 1.0/((long double)i));
+			long double curPMax = powl(curP, 1.0L/((long double)i));
 
 			if(Pmax < curPMax) {
 				Pmax = curPMax;
@@ -335,264 +381,214 @@ void SAalgs32(const uint8_t text[], long int n, int k, double &t_tuple_res, doub
 	return;
 }
 
-void SAalgs64(const uint8_t text[], long int n, int k, double &t_tuple_res, double &lrs_res, const int verbose, const char *label)
-{
-	vector <saidx64_t> sa(n+1, -1); //each value is at most n-1
-	vector <saidx64_t> L(n+2, -1); //each value is at most n-1
-
-   	long int u; //The length of a string: 1 <= u <= v+1 <= n
-   	long int v; //The length of the LRS. 1 <= v <= n-1
-	long int c; //contains a count from A
-	long int j; //0 <= j <= v+1 <= n
-	saidx64_t t; //Takes values from LCP array. 0 <= t < n
-
-	long double Pmax;
-	long double pu;
-
-	assert(n>0);
-	assert(k>0);
-	assert(n <= SAINDEX64_MAX - 1);
-	assert((UINT128_MAX / (uint128_t)n) >= ((uint128_t)n+1U)); // (mult assert)
-
-	calcSALCP64(text, n, sa, L);
-
-	//to conform with Kaufer's conventions
-	L.erase(L.begin());
-	L[n] = 0;
-	assert(L[0] == 0);
-
-	//Find the length of the LRS, v
-
-	v=0;
-	for(long int i=0; i<n; i++) {
-		if(L[i]>v) v = L[i];
+void SAalgs(const uint8_t text[], long int n, int k, double &t_tuple_res, double &lrs_res, const int verbose, const char *label, PhaseTimings *phases = NULL) {
+	if(n < SAINDEX_MAX) {
+		SAalgsIndexed<saidx_t>(text, n, k, t_tuple_res, lrs_res, verbose, label, phases);
+#ifndef NO_SAINDEX40
+	} else if(n < SAINDEX40_MAX) {
+		SAalgsIndexed<saidx40_t>(text, n, k, t_tuple_res, lrs_res, verbose, label, phases);
+#endif
+	} else {
+		SAalgsIndexed<saidx64_t>(text, n, k, t_tuple_res, lrs_res, verbose, label, phases);
 	}
+}
 
-	assert((v>0) && (v < n));
-	//v is now set correctly
-
-	vector <saidx64_t> Q(v+1, 1); //Contains an accumulation of positive counts 1 <= Q[i] <= n
-	vector <saidx64_t> A(v+2, 0); //Contains an accumulation of positive counts 0 <= A[i] <= n
-	//I is set from L
-	//Note that I is indexed by at most j+1.
-	// j takes the value 0 to v+1  (so I[v+2] should work)
-	//(I stores indices of A, and there are only v+2 of these)
-	vector <saidx64_t> I(v+3, 0); //each value is most 0 <= I[i] <= v+2 <= n+1
-
-	j = 0;
-	for(long int i = 1; i <= n; i++) {
-		c = 0;
-		//Note L[0] is already verified to be 0
-		assert(L[i] >= 0);
+template <typename saidx_type>
+long int len_LRS(const uint8_t text[], const int sample_size){
+	vector <saidx_type> sa(sample_size+1, -1);
+	vector <saidx_type> lcp;
 
-		if(L[i] < L[i-1]) {
-			t = L[i-1];
-			assert(j>0);
-			j--;
-			assert(j<=v);
+	return(calcSALCP(text, sample_size, sa, lcp));
+}
 
-			while(t > L[i]) {
-				assert((t>0) && (t <= v));
-				if((j > 0) && (I[j] == t)) {
-					/* update count for non-zero entry of A */
-					A[I[j]] += A[I[j+1]];
-					A[I[j+1]] = 0;
-					j--;
-				}
+//Rolling-hash engine for the LRS length.
+//For a candidate length m, each of the n-m+1 length-m windows is fingerprinted using a polynomial hash modulo the
+//Mersenne prime 2^61-1, and 32 bits of (scrambled) fingerprint are retained. The window positions are radix sorted by
+//fingerprint, so that windows with equal fingerprints are adjacent. Equal fingerprints are then compared directly,
+//so a hash collision only costs time; it never alters the result.
+//Whether some length-m string repeats is monotone in m, so W is found with a galloping and then a binary search over m.
+//This uses 8n bytes (the fingerprints and the sorted positions) rather than the 12n (or 24n) bytes of the SA/LCP path,
+//and it avoids the suffix sort entirely.
+#define LRS_HASH_PRIME 0x1FFFFFFFFFFFFFFFULL
+#define LRS_HASH_BASE 0x0DE3F2B1A5C79E65ULL
+#define LRS_HASH_MIX 0x9E3779B97F4A7C15ULL
+#define LRS_HASH_MAX_COMPARISONS 1024
+
+static inline uint64_t lrs_hash_mulmod(uint64_t a, uint64_t b) {
+	uint128_t prod = (uint128_t)a * (uint128_t)b;
+	uint64_t res = (uint64_t)(prod & LRS_HASH_PRIME) + (uint64_t)(prod >> 61);
+
+	if(res >= LRS_HASH_PRIME) res -= LRS_HASH_PRIME;
+	return res;
+}
 
-				if(Q[t] >= A[I[j+1]]+1) {
-					/*
-					 * Q[t] is at least as large as current count,
-					 * and since Q[t] <= Q[t-1] <= ... <= Q[1],
-					 * there is no need to check zero entries of A
-					 * until next non-zero entry
-					 */
-					if(j > 0) {
-						/* skip to next non-zero entry of A */
-						t = I[j];
-					} else {
-						/*
-						 * no more non-zero entries of A,
-						 * so skip to L[i] (terminate while loop)
-						 */
-						t = L[i];
-					}
-				} else {
-					/* update Q[t] with new maximum count */
-					Q[t--] = A[I[j+1]]+1;
+//Returns 1 if some string of length m occurs at least twice in text, 0 if not,
+//and -1 if too many fingerprint collisions had to be resolved (in which case the caller should use the SA path).
+static int lrs_hash_has_repeat(const uint8_t text[], long int n, long int m, vector<uint32_t> &fp, vector<uint32_t> &order) {
+	long int windows = n - m + 1;
+	uint64_t topPower = 1; //B^(m-1) mod p
+	size_t counts[256];
+	size_t bucketStart[257];
+	atomic<int> result(0); //Set by whichever thread first finds a repeat, or gives up
+
+	assert((m > 0) && (m < n));
+
+	for(long int i=1; i<m; i++) topPower = lrs_hash_mulmod(topPower, LRS_HASH_BASE);
+
+	//Fingerprint all the windows. Each thread starts its chunk with a direct calculation, and then rolls the hash forward.
+	#pragma omp parallel
+	{
+		int nthreads = omp_get_num_threads();
+		int tid = omp_get_thread_num();
+		long int start = (windows / nthreads) * tid + ((tid < windows % nthreads) ? tid : windows % nthreads);
+		long int end = start + windows / nthreads + ((tid < windows % nthreads) ? 1 : 0);
+
+		if(start < end) {
+			uint64_t h = 0;
+			for(long int i=0; i<m; i++) h = lrs_hash_mulmod(h, LRS_HASH_BASE) + text[start+i];
+
+			for(long int i=start; i<end; i++) {
+				//Short windows have small fingerprints, so scramble them (bijectively) before keeping the high bits.
+				fp[i] = (uint32_t)(((h % LRS_HASH_PRIME) * LRS_HASH_MIX) >> 32);
+				if(i+1 < end) {
+					//remove text[i], shift, and add text[i+m]
+					h = (h % LRS_HASH_PRIME) + LRS_HASH_PRIME - lrs_hash_mulmod(topPower, text[i]);
+					h = lrs_hash_mulmod(h % LRS_HASH_PRIME, LRS_HASH_BASE) + text[i+m];
 				}
 			}
-
-			c = A[I[j+1]]; /* store carry over count */
-			A[I[j+1]] = 0;
-		}
-
-		if(L[i] > 0) {
-			if((j < 1) || (I[j] < L[i])) {
-				/* insert index of next non-zero entry of A */
-				assert(j<v);
-				I[++j] = L[i];
-			}
-			A[I[j]] += c+1; /* update count for t = I[j] = L[i] */
 		}
 	}
 
-	//Calculate u
-	for(u=1; (u<=v) && (Q[u] >= 35); u++);
-
-	assert(u > 0);
-	assert(((u == v+1) || ((u <= v) && (Q[u] < 35))));
-	assert(((u == 1) || (Q[u-1] >= 35)));
-	//u is now correctly set.
-
-	//at this point, Q is completely calculated.
-	/*Calculate the various Pmax[i] values. We need not save the actual values, only the largest*/
-	Pmax = -1.0;
-	for(long int i=1; i<u; i++) {
-		long double curP = ((long double)(Q[i]))/((long double)(n-i+1));
-		long double curPMax = powl(curP, 1.0L/(long double)i);
-
-		if(curPMax > Pmax) {
-			Pmax=curPMax;
-		}
-	}
-
-	//finalize the t-tuple estimate
-	if(Pmax > 0.0) {
-		//We encountered a valid t, so we can run the test
-		pu = Pmax + ZALPHA_L*sqrtl(Pmax*(1.0L - Pmax)/((long double)(n - 1)));
-		if(pu > 1.0) {
-			pu = 1.0;
-		}
-
-		t_tuple_res = (double)-log2l(pu);
-
-		if(verbose == 2) printf("%s t-Tuple Estimate: t = %ld, p-hat_max = %.22Lg, p_u = %.22Lg\n", label, u-1, Pmax, pu);
-		else if(verbose == 3) {
-			printf("%s t-Tuple Estimate: t = %ld\n", label, u-1);
-			printf("%s t-Tuple Estimate: p-hat_max = %.22Lg\n", label, Pmax);
-			printf("%s t-Tuple Estimate: p_u = %.22Lg\n", label, pu);
-			printf("%s t-Tuple Estimate: min entropy = %.17g\n", label, t_tuple_res);
-		}
-
-	} else {
-		if(verbose > 1) printf("t-Tuple Estimate: No strings are repeated 35 times. t-Tuple estimate failed.\n");
-		t_tuple_res = -1.0;
-	}
-
-	//calculate the LRS estimate
-	if(v>=u) {
-		vector <uint128_t> S(v+1, 0);
-		memset(A.data(), 0, sizeof(saidx64_t)*((size_t)v+2));
-
-		for(long int i = 1; i <= n; i++) {
-			if((L[i-1] >= u) && (L[i] < L[i-1])) {
-				saidx64_t b = L[i];
-
-				//A[u] stores the number of u-length tuples. We need to eventually clear down to A[u]=A[b+1].
-				if(b < u) b = u-1;
+	//Partition on the top 8 fingerprint bits, so that each of the resulting buckets is small enough to be sorted in cache.
+	memset(counts, 0, sizeof(counts));
+	for(long int i=0; i<windows; i++) counts[fp[i] >> 24]++;
+
+	bucketStart[0] = 0;
+	for(int b=0; b<256; b++) bucketStart[b+1] = bucketStart[b] + counts[b];
+
+	memcpy(counts, bucketStart, sizeof(counts));
+	for(long int i=0; i<windows; i++) order[counts[fp[i] >> 24]++] = (uint32_t)i;
+
+	//Within each bucket, gather the (fingerprint, position) pairs, LSD radix sort them on the remaining 24 fingerprint bits,
+	//and then check each group of equal fingerprints for an actual repeat.
+	#pragma omp parallel
+	{
+		vector<uint64_t> keys;
+		vector<uint64_t> scratch;
+		size_t localCounts[256];
+
+		#pragma omp for schedule(dynamic)
+		for(int bucket=0; bucket<256; bucket++) {
+			long int bucketSize = bucketStart[bucket+1] - bucketStart[bucket];
+			long int comparisons = 0;
+			uint64_t *src;
+			uint64_t *dst;
+
+			if((result.load() != 0) || (bucketSize < 2)) continue;
+
+			keys.resize(bucketSize);
+			scratch.resize(bucketSize);
+			src = keys.data();
+			dst = scratch.data();
+
+			for(long int i=0; i<bucketSize; i++) {
+				uint32_t pos = order[bucketStart[bucket] + i];
+				src[i] = ((uint64_t)fp[pos] << 32) | pos;
+			}
 
-				for(t = L[i-1]; t > b; t--) {
-					uint128_t priorS;
-					uint128_t choices;
-					A[t] += A[t+1];
-					A[t+1] = 0;
+			for(int shift=32; shift<56; shift+=8) {
+				size_t offset = 0;
 
-					assert(A[t] >= 0);
-					// update sum
-					// Note that (c choose 2) is just (c)(c-1)/2.
-					// The numerator of this expression is necessarily even
-					// Dividing an even quantity by 2 is the same as right shifting by 1.
-					// Check for overflows when adding to S[t] (unsigned 64 bit integers)
-					// Note, A[t] <= n, so the assert marked "(mult assert)" tells us that the multiplication won't rollover.
+				memset(localCounts, 0, sizeof(localCounts));
+				for(long int i=0; i<bucketSize; i++) localCounts[(src[i] >> shift) & 0xFF]++;
 
-					priorS = S[t];
-					choices = ((((uint128_t)(A[t]+1) * (uint128_t)(A[t]))))>>1;
-					S[t] = priorS + choices;
-					assert(S[t] >= priorS);
+				for(int b=0; b<256; b++) {
+					size_t curCount = localCounts[b];
+					localCounts[b] = offset;
+					offset += curCount;
 				}
 
-				if(b >= u) A[b] += A[b+1]; /* carry over count for t = L[i] */
-				A[b+1] = 0;
+				for(long int i=0; i<bucketSize; i++) dst[localCounts[(src[i] >> shift) & 0xFF]++] = src[i];
+				swap(src, dst);
 			}
 
-			if(L[i] >= u) A[L[i]]++; /* update count for t = L[i] */
-		}
-
-		//We now have a complete set of numerators in S
-		Pmax = 0.0;
-		for(long int i=u; i<=v; i++) {
-			// Note, the assert marked "(mult assert)" tells us that the multiplication won't rollover.
-			uint128_t choices = (((uint128_t)n-(uint128_t)i)*((uint128_t)n-(uint128_t)i+1U))>>1;
-			long double curP = ((long double)S[i]) / (long double)choices;
-			long double curPMax = powl(curP, 1.0L/((long double)i));
-
+			for(long int i=0; (i+1<bucketSize) && (result.load() == 0); ) {
+				long int groupEnd = i+1;
+
+				while((groupEnd < bucketSize) && ((src[groupEnd] >> 32) == (src[i] >> 32))) groupEnd++;
+
+				for(long int a=i; (a+1<groupEnd) && (result.load() == 0); a++) {
+					for(long int b=a+1; b<groupEnd; b++) {
+						if(memcmp(text + (uint32_t)src[a], text + (uint32_t)src[b], m) == 0) {
+							result.store(1);
+							break;
+						}
+						if(++comparisons > LRS_HASH_MAX_COMPARISONS + bucketSize/64) {
+							//Giving up mustn't hide a repeat that another thread has already found
+							int unset = 0;
+							result.compare_exchange_strong(unset, -1);
+							break;
+						}
+					}
+				}
 
-			if(Pmax < curPMax) {
-				Pmax = curPMax;
+				i = groupEnd;
 			}
 		}
-
-		pu = Pmax + ZALPHA_L*sqrtl(Pmax*(1.0L - Pmax)/((long double)(n - 1)));
-		if(pu > 1.0) {
-			pu = 1.0;
-		}
-
-		lrs_res = -log2(pu);
-
-		if(verbose == 2) printf("%s LRS Estimate: u = %ld, v = %ld, p-hat = %.22Lg, p_u = %.22Lg\n", label, u, v, Pmax, pu);
-		else if(verbose == 3) {
-			printf("%s LRS Estimate: u = %ld\n", label, u);
-			printf("%s LRS Estimate: v = %ld\n", label, v);
-			printf("%s LRS Estimate: p-hat = %.22Lg\n", label, Pmax);
-			printf("%s LRS Estimate: p_u = %.22Lg\n", label, pu);
-			printf("%s LRS Estimate: min entropy = %.17g\n", label, lrs_res);
-		}
-
-	} else {
-		printf("LRS Estimate: v<u. Can't Run LRS Test.\n");
-		lrs_res = -1.0;
-		return;
 	}
 
-	return;
+	return result.load();
 }
 
-void SAalgs(const uint8_t text[], long int n, int k, double &t_tuple_res, double &lrs_res, const int verbose, const char *label) {
-	if(n<SAINDEX_MAX) {
-		SAalgs32(text, n, k, t_tuple_res, lrs_res, verbose, label);
-	} else {
-		SAalgs64(text, n, k, t_tuple_res, lrs_res, verbose, label);
-	}
-}
+//Returns the length of the longest repeated substring, or -1 if the caller should fall back to the SA path.
+//guess is a starting point for the search (e.g., the expected LRS length under an IID assumption).
+long int len_LRS_hash(const uint8_t text[], const int sample_size, long int guess) {
+	long int n = sample_size;
+	long int lo = 0; //the longest length known to repeat
+	long int hi = n; //the shortest length known not to repeat
+	long int m;
+	int res;
 
-long int len_LRS32(const uint8_t text[], const int sample_size){
-	vector <saidx_t> sa(sample_size+1, -1);
-	vector <saidx_t> lcp(sample_size+1, -1);
-	saidx_t lrs_len = -1;
+	assert(n > 0);
 
-	calcSALCP32(text, sample_size, sa, lcp);
+	if(n < 2) return 0;
 
-	for(saidx_t j = 0; j <= sample_size; j++) {
-		if(lcp[j] > lrs_len) lrs_len = lcp[j];
-	}
+	vector<uint32_t> fp(n);
+	vector<uint32_t> order(n);
 
-	return(lrs_len);
-}
+	if(guess < 1) guess = 1;
+	if(guess > n-1) guess = n-1;
+
+	//Galloping search to bracket W
+	m = guess;
+	while(lo + 1 < hi) {
+		res = lrs_hash_has_repeat(text, n, m, fp, order);
+		if(res < 0) return -1;
 
-long int len_LRS64(const uint8_t text[], const int sample_size){
-	vector <saidx64_t> sa(sample_size+1, -1);
-	vector <saidx64_t> lcp(sample_size+1, -1);
-	saidx64_t lrs_len = -1;
+		if(res == 1) {
+			lo = m;
+			if(2*m >= hi) break;
+			m = 2*m;
+		} else {
+			hi = m;
+			if(m/2 <= lo) break;
+			m = m/2;
+		}
+	}
 
-	calcSALCP64(text, sample_size, sa, lcp);
+	//Binary search within the bracket (lo repeats, hi doesn't)
+	while(lo + 1 < hi) {
+		m = lo + (hi - lo)/2;
+		res = lrs_hash_has_repeat(text, n, m, fp, order);
+		if(res < 0) return -1;
 
-	for(saidx64_t j = 0; j <= sample_size; j++) {
-		if(lcp[j] > lrs_len) lrs_len = lcp[j];
+		if(res == 1) lo = m;
+		else hi = m;
 	}
 
-	return(lrs_len);
+	return lo;
 }
+
 /*
 * ---------------------------------------------
 *			 HELPER FUNCTIONS
@@ -614,7 +610,7 @@ void calc_collision_proportion(const vector<double> &p, long double &p_col){
 * ---------------------------------------------
 */
 
-bool len_LRS_test(const uint8_t data[], const int L, const int k, const int verbose, const char *label) {
+bool len_LRS_test(const uint8_t data[], const int L, const int k, const int verbose, const char *label, PhaseTimings *phases = NULL) {
 	// p_col is the probability of collision on a per-symbol basis under an IID assumption (this is related to the collision entropy).
 	// p_col >= 1/k, which bounds this.
 	// Note, for SP 800-90B k<=256, so we can bound p_col >= 2^-8.
@@ -640,12 +636,25 @@ bool len_LRS_test(const uint8_t data[], const int L, const int k, const int verb
 	assert(p_col < 1.0L);
 
 	// The length of the longest repeated substring (LRS) for the supplied data is W.
-	long int W;
-	if(L<SAINDEX_MAX) {
-		W = len_LRS32(data, L);
-	} else {
-		W = len_LRS64(data, L);
+	// The expected W under an IID assumption (roughly where the expected number of colliding pairs is 1) is a good starting point for the search.
+	PhaseTimer lrsTimer(string("LRS length (") + label + ")", phases);
+	long int W = len_LRS_hash(data, L, lrintl(2.0L*logl((long double)L) / -logl(p_col)));
+
+	// If the hash engine had to give up, fall back to the suffix array. 4 byte indexes suffice unless L is INT32_MAX
+	// (calcSALCP requires L < SAINDEX_MAX), in which case the wider indexes are used.
+	if(W < 0) {
+		if(L < SAINDEX_MAX) {
+			W = len_LRS<saidx_t>(data, L);
+#ifndef NO_SAINDEX40
+		} else {
+			W = len_LRS<saidx40_t>(data, L);
+#else
+		} else {
+			W = len_LRS<saidx64_t>(data, L);
+#endif
+		}
 	}
+	lrsTimer.Stop();
 
 	// p_col^W is the probability of collision of a W-length string under an IID assumption;
 	// this may be quite close to 0.
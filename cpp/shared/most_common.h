@@ -13,8 +13,7 @@ double most_common(uint8_t* data, const long len, const int alph_size, const int
 
 	assert(len > 1);
 
-	for(i = 0; i < alph_size; i++) counts[i] = 0;
-	for (i = 0; i < len; i++) counts[data[i]]++;
+	histogram(data, len, alph_size, counts);
 
 	mode = 0;
 	for(i = 0; i < alph_size; i++){
@@ -0,0 +1,127 @@
+#pragma once
+#include "utils.h"
+
+//The simulation rounds are split into chunks of this many rounds, each with its own RNG stream
+#define SIMULATION_CHUNK 65536UL
+
+//The RNG stream used (see seed) for the simulation
+#define RESTART_SIMULATION_STREAM 0
+
+// Here, we simulate a "worst case" for the restart sanity test. This is "worst case" in the sense that the adopted distribution
+// results in the largest acceptable collision bound for a given assessed entropy level, so if a data sample fails this
+// test, it is likely to indicate an underlying problem.
+//
+// This "worst case" uses the "inverted near-uniform" family (see Hagerty-Draper "Entropy Bounds and Statistical Tests" for
+// a full definition of this distribution and justification for its use here).
+//
+// This distribution has as many maximal probability symbols as possible (each occurring with probability p), and possibly one
+// additional symbol that contains all the residual probability.
+//
+// If the probability for the most likely symbol is p, then there are floor(1/p) most likely symbols,
+// each occurring with probability p and possibly one additional symbol that has all the remaining (1 - p floor(1/p)) chance.
+// In this code, we generate a random unit value in the range [0, 1), and we need to map this to one of the ceil(1/p) possible
+// output symbols.
+//
+// Note that the function x -> floor(x/p) yields
+// [0p,1p) -> 0
+// [1p, 2p) -> 1
+// [2p, 3p) -> 2
+// ...
+// [(floor(1/p)-1)p, floor(1/p)p) -> floor(1/p)-1
+// [ floor(1/p)p, 1 ) -> floor(1/p)
+//
+// As such, each of the first floor(1/p) symbols (0 through floor(1/p)-1) have probability p of occurring, and
+// the symbol floor(1/p) has probability 1-floor(1/p)p of occurring, as desired.
+//
+// Note that if floor(1/p) = ceil(1/p) = 1/p, then there is no "residual" symbol, only 1/p most likely symbols.
+//
+// The array is 0-indexed, so we can use this map to establish the index directly.
+uint16_t simulateCount(int k_effective, double p, xoshiroBulkState &rng) {
+    uint16_t counts[256] = {0};
+    uint16_t max_count = 0;
+    double u[1000];
+
+    xoshiroFillUnit(rng, u, 1000);
+    for (int j = 0; j < 1000; j++) {
+        // Note that (int)floor(u[j] / p) is the index map discussed in the above comments.
+        counts[(int)floor(u[j] / p)]++;
+    }
+
+    // We could have tracked this during the above loop, but that would yield 1000 comparisons,
+    // rather than k_effective (<= 256) comparisons, as here.
+    for (int j = 0; j < k_effective; j++) {
+        if (max_count < counts[j]) max_count = counts[j];
+    }
+
+    return max_count;
+}
+
+//This returns the bound (cutoff) for the test. Counts equal to this value should pass.
+//Larger values should fail.
+
+int simulateBound(double alpha, int k, double H_I, unsigned long int simulation_rounds) {
+    uint64_t xoshiro256starstarMainSeed[4];
+    uint16_t *results;
+    long int returnIndex;
+    double p;
+    int k_effective;
+    int returnValue;
+
+    assert((k > 1) && (k <= 256));
+
+    // A few constraints:
+    // This array may be very large (many gigabytes) so can't go onto the stack
+    // Many of the C++ STL-derived types are not thread safe. Our mode of access is
+    // quite straight forward, but there are clearly issues in some cases.
+    // In C, calloc is possibly faster, but this is probably the best we can do
+    // using somewhat idiomatic C++.
+    results = new uint16_t[simulation_rounds];
+    memset(results, 0, sizeof(uint16_t)*simulation_rounds);
+
+    //The probability of the most likely symbol (MLS) only needs to be calculated once...
+    p = pow(2.0, -H_I);
+
+    //if floor(1/p) = ceil(1/p) = 1/p, then there are exactly that many symbols (e.g., p=1/2, then there are 2 symbols expected).
+    //If ceil(1/p) > 1/p, then ceil(1/p) = floor(1/p)+1, that is there are the floor(1/p) most likely symbols, and then the extra
+    //symbol that fills the rest of the space (with probability < p).
+    k_effective = ceil(1.0 / p);
+    assert(k_effective <= k);
+
+    seed(xoshiro256starstarMainSeed, RESTART_SIMULATION_STREAM);
+
+    // The rounds are split into fixed chunks, and chunk c uses the RNG stream found by jumping the main seed c times
+    // (c * 2^128 calls), so that the results don't depend on the number of threads.
+#pragma omp parallel
+    {
+        uint64_t xoshiro256starstarSeed[4];
+        unsigned long int streamIndex = 0; // The stream currently in xoshiro256starstarSeed
+        xoshiroBulkState rng;
+
+        memcpy(xoshiro256starstarSeed, xoshiro256starstarMainSeed, sizeof (xoshiro256starstarMainSeed));
+
+#pragma omp for schedule(dynamic)
+        for (unsigned long int c = 0; c < (simulation_rounds + SIMULATION_CHUNK - 1) / SIMULATION_CHUNK; c++) {
+            // Each thread is assigned increasing chunk indices, so only a few jumps are needed to reach stream c.
+            xoshiro_jump((unsigned int)(c - streamIndex), xoshiro256starstarSeed);
+            streamIndex = c;
+            xoshiroBulkInit(rng, xoshiro256starstarSeed);
+
+            for (unsigned long int i = c * SIMULATION_CHUNK; (i < (c + 1) * SIMULATION_CHUNK) && (i < simulation_rounds); i++) {
+                results[i] = simulateCount(k_effective, p, rng);
+            }
+        }
+    }
+
+    sort(results, results+simulation_rounds);
+    assert((results[0] >= (1000 / k)) && (results[0] <= 1000));
+    assert((results[simulation_rounds - 1] >= (1000 / k)) && (results[simulation_rounds - 1] <= 1000));
+
+    returnIndex = ((size_t) floor((1.0 - alpha) * ((double) simulation_rounds))) - 1;
+    assert((returnIndex >= 0) && (returnIndex < simulation_rounds));
+
+    returnValue = (int)results[returnIndex];
+
+    delete[] results;
+
+    return returnValue;
+}
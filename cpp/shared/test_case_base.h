@@ -4,6 +4,7 @@
 #include <cstdlib>
 #include <string>
 #include <json/json.h>
+#include "timing.h"
 
 using namespace std;
 
@@ -23,6 +24,9 @@ public:
 
     string testCaseNumber;
 
+    // The cost of running this test case (see PhaseTimer)
+    PhaseTiming timing;
+
 protected:
     Json::Value GetBaseJson() {
         Json::Value baseJson;
@@ -48,6 +52,9 @@ protected:
         // not needed in every test case, easier to exclude for now
         //baseJson["mcvEstimate"] = literal_mcv_estimate ? "literal" : "bitstring";
 
+        if(timing.recorded)
+            baseJson["timing"] = timing.GetAsJson();
+
         return baseJson;
     }
 };
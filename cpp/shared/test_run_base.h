@@ -1,9 +1,10 @@
 #ifndef TESTRUN_H
 #define TESTRUN_H
 
-#include "utils.h"
+#include "data.h"
 #include <string>
 #include <json/json.h>
+#include "timing.h"
 
 using namespace std;
 
@@ -16,6 +17,8 @@ public:
     string errorMsg;
     string type;
     string commandline;
+    // The phases timed during this run (see PhaseTimer)
+    PhaseTimings phases;
 
 protected:
     Json::Value GetBaseJson() {
@@ -35,7 +38,26 @@ protected:
         if(!sha256.empty()) {
             baseJson["sha256"] = sha256;
         }
+
+        vector<PhaseTiming> runPhases = phases.Snapshot();
+        if(!runPhases.empty()) {
+            Json::Value phasesJson(Json::arrayValue);
+            for(size_t i = 0; i < runPhases.size(); i++) {
+                phasesJson.append(runPhases[i].GetAsJson());
+            }
+            baseJson["timing"]["phases"] = phasesJson;
+        }
         return baseJson;
     }
+
+    // Prints the recorded phases (used for the --profile option)
+    void PrintBaseTiming() {
+        vector<PhaseTiming> runPhases = phases.Snapshot();
+
+        printf("\nPhase timing:\n");
+        for(size_t i = 0; i < runPhases.size(); i++) {
+            runPhases[i].Print(runPhases[i].name.c_str());
+        }
+    }
 };
 #endif /* TESTRUN_H */
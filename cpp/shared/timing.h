@@ -0,0 +1,148 @@
+#ifndef TIMING_H
+#define TIMING_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <time.h>
+#include <sys/resource.h>
+#include <omp.h>
+#include <json/json.h>
+
+using namespace std;
+
+/* The cost of part of a run: the wall time, the CPU time (of the whole process, so that the ratio of the two
+ * reflects the parallelism), the growth in the peak resident set size, and the number of threads available.
+ */
+class PhaseTiming {
+public:
+    string name;
+    double wallSeconds = 0.0;
+    double cpuSeconds = 0.0;
+    long peakRssDeltaKiB = 0;
+    int threads = 0;
+    bool recorded = false;
+
+    Json::Value GetAsJson() const {
+        Json::Value json;
+        if (!name.empty())
+            json["name"] = name;
+        json["wallSeconds"] = wallSeconds;
+        json["cpuSeconds"] = cpuSeconds;
+        json["peakRssDeltaKiB"] = (Json::Int64)peakRssDeltaKiB;
+        json["threads"] = threads;
+        return json;
+    }
+
+    void Print(const char *label) const {
+        printf("\t%-56s %10.3f s wall %10.3f s CPU %10ld KiB peak RSS delta %4d thread(s)\n", label, wallSeconds, cpuSeconds, peakRssDeltaKiB, threads);
+    }
+};
+
+/* The phases (e.g., loading, hashing, suffix array construction and the permutation loop) of a run, in the order
+ * that they finish. Each test run has its own (see TestRunBase), so runs made at the same time (e.g., by a program
+ * that embeds libentropyassessment) don't see each other's phases. Phases of the same run may finish in several
+ * threads at once, so the list is locked.
+ */
+class PhaseTimings {
+public:
+    PhaseTimings() {}
+
+    PhaseTimings(const PhaseTimings &other) : phases(other.Snapshot()) {}
+
+    PhaseTimings &operator=(const PhaseTimings &other) {
+        if (this != &other) {
+            vector<PhaseTiming> otherPhases = other.Snapshot();
+            lock_guard<mutex> lock(phasesMutex);
+            phases = otherPhases;
+        }
+        return *this;
+    }
+
+    void Add(const PhaseTiming &timing) {
+        lock_guard<mutex> lock(phasesMutex);
+        phases.push_back(timing);
+    }
+
+    vector<PhaseTiming> Snapshot() const {
+        lock_guard<mutex> lock(phasesMutex);
+        return phases;
+    }
+
+private:
+    vector<PhaseTiming> phases;
+    mutable mutex phasesMutex;
+};
+
+inline double timingWallSeconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+
+inline double timingCpuSeconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+
+//The peak resident set size so far (Linux reports this in KiB)
+inline long timingPeakRssKiB() {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+    return usage.ru_maxrss;
+}
+
+/* Times the enclosing scope (or until Stop() is called). The result goes into the supplied PhaseTiming
+ * (e.g., the timing of a test case), or is added to the phases of a run (if these are not NULL).
+ */
+class PhaseTimer {
+public:
+    PhaseTimer(const string &name, PhaseTimings *phases) : target(NULL), phases(phases), stopped(false) {
+        Start(name);
+    }
+
+    explicit PhaseTimer(PhaseTiming &timing) : target(&timing), phases(NULL), stopped(false) {
+        Start("");
+    }
+
+    ~PhaseTimer() {
+        Stop();
+    }
+
+    void Stop() {
+        if (stopped) return;
+        stopped = true;
+
+        timing.wallSeconds = timingWallSeconds() - timing.wallSeconds;
+        timing.cpuSeconds = timingCpuSeconds() - timing.cpuSeconds;
+        timing.peakRssDeltaKiB = timingPeakRssKiB() - timing.peakRssDeltaKiB;
+        timing.recorded = true;
+
+        if (target != NULL) {
+            *target = timing;
+        } else if (phases != NULL) {
+            phases->Add(timing);
+        }
+    }
+
+private:
+    PhaseTiming timing;
+    PhaseTiming *target;
+    PhaseTimings *phases;
+    bool stopped;
+
+    PhaseTimer(const PhaseTimer &);
+    PhaseTimer &operator=(const PhaseTimer &);
+
+    void Start(const string &name) {
+        timing.name = name;
+        timing.threads = omp_get_max_threads();
+        timing.peakRssDeltaKiB = timingPeakRssKiB();
+        timing.cpuSeconds = timingCpuSeconds();
+        timing.wallSeconds = timingWallSeconds();
+    }
+};
+
+#endif /* TIMING_H */
@@ -1,6 +1,3 @@
-//Version of the tool
-#define VERSION "1.1.8"
-
 #pragma once
 #include <iostream>		// std::cout
 #include <string>		// std::string
@@ -19,18 +16,18 @@
 #include <omp.h>		// openmp 4.0 with gcc 4.9
 #include <bitset>
 #include <mutex>		// std::mutex
+#include <errno.h>		// errno
+#include <ctype.h>		// isxdigit
 #include <assert.h>
 #include <cfloat>
 #include <math.h>
+#include "data.h"
 #include "test_run_base.h"
 
 #define SWAP(x, y) do { int s = x; x = y; y = s; } while(0)
 #define INOPENINTERVAL(x, a, b) (((a)>(b))?(((x)>(b))&&((x)<(a))):(((x)>(a))&&((x)<(b))))
 #define INCLOSEDINTERVAL(x, a, b) (((a)>(b))?(((x)>=(b))&&((x)<=(a))):(((x)>=(a))&&((x)<=(b))))
 
-#define MIN_SIZE 1000000
-#define PERMS 10000
-
 //This is the smallest practical value (one can't do better with the double type)
 #define RELEPSILON DBL_EPSILON
 //This is clearly overkill, but it's difficult to do better without a view into the monotonic function
@@ -51,21 +48,6 @@ typedef unsigned __int128 uint_least128_t;
 # define UINT128_C(N)        ((uint_least128_t)+N ## WBU)
 #endif
 
-typedef struct data_t data_t;
-
-struct data_t{
-	int word_size; 		// bits per symbol
-	int alph_size; 		// symbol alphabet size
-	uint8_t maxsymbol; 	// the largest symbol present in the raw data stream
-	uint8_t *rawsymbols; 	// raw data words
-	uint8_t *symbols; 		// data words
-	uint8_t *bsymbols; 	// data words as binary string
-	long len; 		// number of words in data
-	long blen; 		// number of bits in data
-};
-
-
-
 using namespace std;
 
 //This generally performs a check for relative closeness, but (if that check would be nonsense)
@@ -177,6 +159,7 @@ bool read_file_subset(const char *file_path, data_t *dp, unsigned long subsetInd
 	int mask, j, max_symbols;
 	long rc, i;
 	long fileLen;
+	PhaseTimer loadTimer("Load", &testRun->phases);
 
 	file = fopen(file_path, "rb");
 	if(!file){
@@ -260,6 +243,10 @@ bool read_file_subset(const char *file_path, data_t *dp, unsigned long subsetInd
 		return false;
 	}
 	fclose(file);
+	loadTimer.Stop();
+
+	//Translate the symbols and build the bitstring
+	PhaseTimer preprocessingTimer("Preprocessing", &testRun->phases);
 
 	//Do we need to establish the word size?
 	if(dp->word_size == 0) {
@@ -357,6 +344,7 @@ bool read_file(const char *file_path, data_t *dp, TestRunBase *testRun){
 	FILE *file; 
 	int mask, j, max_symbols;
 	long rc, i;
+	PhaseTimer loadTimer("Load", &testRun->phases);
 
 	file = fopen(file_path, "rb");
 	if(!file){
@@ -425,6 +413,10 @@ bool read_file(const char *file_path, data_t *dp, TestRunBase *testRun){
 		return false;
 	}
 	fclose(file);
+	loadTimer.Stop();
+
+	//Translate the symbols and build the bitstring
+	PhaseTimer preprocessingTimer("Preprocessing", &testRun->phases);
 
 	//Do we need to establish the word size?
 	if(dp->word_size == 0) {
@@ -520,6 +512,128 @@ bool read_file(const char *file_path, data_t *dp, TestRunBase *testRun){
 	return true;
 }
 
+// Sets up *dp to describe the len samples in buffer, without copying them. As for read_file, dp->word_size is either
+// the number of bits per symbol, or 0 (in which case it is inferred from the data).
+// The buffer is owned by the caller, and must outlive *dp; it is not modified. The raw symbols are the buffer itself, as
+// are the symbols when no translation is needed (that is, when the symbols present are 0, 1, ..., maxsymbol). Only the
+// translated symbols (if needed) and the bitstring (for symbols wider than 1 bit) are allocated.
+// Release *dp using free_data_view rather than free_data.
+bool view_buffer(const uint8_t *buffer, long len, data_t *dp, TestRunBase *testRun) {
+	int j, max_symbols;
+	long i;
+	uint8_t datamask = 0;
+	uint8_t curbit = 0x80;
+	PhaseTimer preprocessingTimer("Preprocessing", &testRun->phases);
+
+	dp->rawsymbols = NULL;
+	dp->symbols = NULL;
+	dp->bsymbols = NULL;
+
+	if((buffer == NULL) || (len <= 0)){
+		testRun->errorLevel = -1;
+		testRun->errorMsg = "Error: the buffer is empty";
+		printf("Error: the buffer is empty\n");
+		return false;
+	}
+
+	//The caller supplies word_size directly (rather than through the command line checks of the programs)
+	if((dp->word_size < 0) || (dp->word_size > 8)) {
+		testRun->errorLevel = -1;
+		testRun->errorMsg = "Error: Invalid bits per symbol: " + std::to_string(dp->word_size) + ".";
+		printf("Error: Invalid bits per symbol: %d.\n", dp->word_size);
+		return false;
+	}
+
+	for(i = 0; i < len; i++) {
+		datamask = datamask | buffer[i];
+	}
+
+	for(i=8; (i>0) && ((datamask & curbit) == 0); i--) {
+		curbit = curbit >> 1;
+	}
+
+	//Do we need to establish the word size?
+	if(dp->word_size == 0) {
+		dp->word_size = i;
+	} else if( i < dp->word_size ) {
+		printf("Warning: Symbols appear to be narrower than described.\n");
+		testRun->errorMsg = "Warning: Symbols appear to be narrower than described.";
+	} else if( i > dp->word_size ) {
+		testRun->errorLevel = -1;
+		testRun->errorMsg = "Error: Incorrect bit width specification: Data (" + std::to_string(i) + ") does not fit within described bit width: " + std::to_string(dp->word_size) + ".";
+		printf("Incorrect bit width specification: Data (%ld) does not fit within described bit width: %d.\n",i,dp->word_size);
+		return false;
+	}
+
+	//Every sample fits within word_size bits, so (unlike read_file) there is no need to mask the samples
+	dp->len = len;
+	dp->rawsymbols = (uint8_t *)buffer;
+	dp->maxsymbol = 0;
+
+	max_symbols = 1 << dp->word_size;
+	int symbol_map_down_table[max_symbols];
+
+	dp->alph_size = 0;
+	memset(symbol_map_down_table, 0, max_symbols*sizeof(int));
+	for(i = 0; i < dp->len; i++){
+		if(buffer[i] > dp->maxsymbol) dp->maxsymbol = buffer[i];
+		symbol_map_down_table[buffer[i]] = 1;
+	}
+
+	for(i = 0; i < max_symbols; i++){
+		if(symbol_map_down_table[i] != 0) symbol_map_down_table[i] = (uint8_t)dp->alph_size++;
+	}
+
+	// map down symbols if less than 2^bits_per_word unique symbols
+	if(dp->alph_size < dp->maxsymbol + 1){
+		dp->symbols = (uint8_t*)malloc(sizeof(uint8_t)*dp->len);
+		if(dp->symbols == NULL){
+			testRun->errorLevel = -1;
+			testRun->errorMsg = "Error: failure to initialize memory for symbols";
+			printf("Error: failure to initialize memory for symbols\n");
+			dp->rawsymbols = NULL;
+			return false;
+		}
+		for(i = 0; i < dp->len; i++) dp->symbols[i] = (uint8_t)symbol_map_down_table[buffer[i]];
+	} else {
+		dp->symbols = dp->rawsymbols;
+	}
+
+	// create bsymbols (bitstring) using the non-mapped data
+	dp->blen = dp->len * dp->word_size;
+	if(dp->word_size == 1) dp->bsymbols = dp->symbols;
+	else{
+		dp->bsymbols = (uint8_t*)malloc(dp->blen);
+		if(dp->bsymbols == NULL){
+			testRun->errorLevel = -1;
+			testRun->errorMsg = "Error: failure to initialize memory for bsymbols";
+			printf("Error: failure to initialize memory for bsymbols\n");
+			if(dp->symbols != dp->rawsymbols) free(dp->symbols);
+			dp->symbols = NULL;
+			dp->rawsymbols = NULL;
+			return false;
+		}
+
+		for(i = 0; i < dp->len; i++){
+			for(j = 0; j < dp->word_size; j++){
+				dp->bsymbols[i*dp->word_size+j] = (buffer[i] >> (dp->word_size-1-j)) & 0x1;
+			}
+		}
+	}
+
+	return true;
+}
+
+// Releases the buffers allocated by view_buffer (but not the caller's buffer)
+void free_data_view(data_t *dp){
+	if((dp->symbols != NULL) && (dp->symbols != dp->rawsymbols)) free(dp->symbols);
+	//bsymbols is allocated unless it is the symbols themselves (1 bit samples); this includes an all-zero buffer (word_size 0)
+	if((dp->bsymbols != NULL) && (dp->bsymbols != dp->symbols)) free(dp->bsymbols);
+	dp->symbols = NULL;
+	dp->rawsymbols = NULL;
+	dp->bsymbols = NULL;
+}
+
 /* This is xoshiro256** 1.0*/
 /*This implementation is derived from David Blackman and Sebastiano Vigna, which they placed into
 the public domain. See http://xoshiro.di.unimi.it/xoshiro256starstar.c
@@ -550,12 +664,14 @@ static inline uint64_t xoshiro256starstar(uint64_t *xoshiro256starstarState)
    non-overlapping subsequences for parallel computations. */
 void xoshiro_jump(unsigned int jump_count, uint64_t *xoshiro256starstarState) {
 	static const uint64_t JUMP[] = { 0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c };
-	uint64_t s0 = 0;
-	uint64_t s1 = 0;
-	uint64_t s2 = 0;
-	uint64_t s3 = 0;
 
 	for(unsigned int j=0; j < jump_count; j++) {
+		//Each jump starts afresh (otherwise, the later jumps aren't jumps of 2^128 calls)
+		uint64_t s0 = 0;
+		uint64_t s1 = 0;
+		uint64_t s2 = 0;
+		uint64_t s3 = 0;
+
 		for(unsigned int i = 0; i < sizeof JUMP / sizeof *JUMP; i++)
 			for(unsigned int b = 0; b < 64; b++) {
 				if (JUMP[i] & ((uint64_t)1) << b) {
@@ -574,12 +690,201 @@ void xoshiro_jump(unsigned int jump_count, uint64_t *xoshiro256starstarState) {
 	}
 }
 
+/* This is the long-jump function for the generator. It is equivalent to 2^192 calls to xoshiro256starstar(), so
+   the streams started from each long-jump are also separated by (up to) 2^64 calls to xoshiro_jump. */
+void xoshiro_long_jump(unsigned int jump_count, uint64_t *xoshiro256starstarState) {
+	static const uint64_t LONG_JUMP[] = { 0x76e15d3efefdcbbf, 0xc5004e441c522fb3, 0x77710069854ee241, 0x39109bb02acbe635 };
+
+	for(unsigned int j=0; j < jump_count; j++) {
+		uint64_t s0 = 0;
+		uint64_t s1 = 0;
+		uint64_t s2 = 0;
+		uint64_t s3 = 0;
+
+		for(unsigned int i = 0; i < sizeof LONG_JUMP / sizeof *LONG_JUMP; i++)
+			for(unsigned int b = 0; b < 64; b++) {
+				if (LONG_JUMP[i] & ((uint64_t)1) << b) {
+					s0 ^= xoshiro256starstarState[0];
+					s1 ^= xoshiro256starstarState[1];
+					s2 ^= xoshiro256starstarState[2];
+					s3 ^= xoshiro256starstarState[3];
+				}
+				xoshiro256starstar(xoshiro256starstarState);
+			}
+
+		xoshiro256starstarState[0] = s0;
+		xoshiro256starstarState[1] = s1;
+		xoshiro256starstarState[2] = s2;
+		xoshiro256starstarState[3] = s3;
+	}
+}
+
+/* Bulk generation.
+ * The consumers (e.g., the shuffles in the permutation tests and the restart simulation) draw a great many values,
+ * so values are generated XOSHIRO_BUFFER at a time. By default, there are XOSHIRO_LANES independent generators
+ * (lane j is the starting state long-jumped j times) which are stepped together, so that the compiler can use vector
+ * instructions, and the output is interleaved (one value from each lane in turn).
+ * In the "scalar" mode, the values are instead exactly those that repeated calls to xoshiro256starstar() would yield,
+ * which is useful for comparing against earlier results. Defining XOSHIRO_SCALAR_STREAM makes this the default mode.
+ */
+#define XOSHIRO_LANES 8
+#define XOSHIRO_BUFFER 256
+
+#ifdef XOSHIRO_SCALAR_STREAM
+#define XOSHIRO_DEFAULT_SCALAR true
+#else
+#define XOSHIRO_DEFAULT_SCALAR false
+#endif
+
+struct xoshiroBulkState {
+	uint64_t s[4][XOSHIRO_LANES]; // word i of lane j is s[i][j]. In scalar mode, only lane 0 is used.
+	bool scalar;
+	int next; // the index of the next unused value in buffer
+	uint64_t buffer[XOSHIRO_BUFFER];
+};
+
+void xoshiroBulkInit(xoshiroBulkState &bs, const uint64_t *xoshiro256starstarState, bool scalar = XOSHIRO_DEFAULT_SCALAR) {
+	uint64_t laneState[4];
+
+	memcpy(laneState, xoshiro256starstarState, sizeof(laneState));
+	bs.scalar = scalar;
+	bs.next = XOSHIRO_BUFFER;
+
+	for(int j = 0; j < XOSHIRO_LANES; j++) {
+		if(j > 0) {
+			if(scalar) break;
+			xoshiro_long_jump(1, laneState);
+		}
+		for(int i = 0; i < 4; i++) bs.s[i][j] = laneState[i];
+	}
+}
+
+static void xoshiroBulkRefill(xoshiroBulkState &bs) {
+	if(bs.scalar) {
+		uint64_t state[4] = {bs.s[0][0], bs.s[1][0], bs.s[2][0], bs.s[3][0]};
+
+		for(int k = 0; k < XOSHIRO_BUFFER; k++) bs.buffer[k] = xoshiro256starstar(state);
+		for(int i = 0; i < 4; i++) bs.s[i][0] = state[i];
+	} else {
+		uint64_t s0[XOSHIRO_LANES], s1[XOSHIRO_LANES], s2[XOSHIRO_LANES], s3[XOSHIRO_LANES];
+
+		memcpy(s0, bs.s[0], sizeof(s0));
+		memcpy(s1, bs.s[1], sizeof(s1));
+		memcpy(s2, bs.s[2], sizeof(s2));
+		memcpy(s3, bs.s[3], sizeof(s3));
+
+		for(int k = 0; k < XOSHIRO_BUFFER; k += XOSHIRO_LANES) {
+			#pragma omp simd
+			for(int j = 0; j < XOSHIRO_LANES; j++) {
+				const uint64_t t = s1[j] << 17;
+
+				bs.buffer[k + j] = rotl(s1[j] * 5, 7) * 9;
+
+				s2[j] ^= s0[j];
+				s3[j] ^= s1[j];
+				s1[j] ^= s2[j];
+				s0[j] ^= s3[j];
+				s2[j] ^= t;
+				s3[j] = rotl(s3[j], 45);
+			}
+		}
+
+		memcpy(bs.s[0], s0, sizeof(s0));
+		memcpy(bs.s[1], s1, sizeof(s1));
+		memcpy(bs.s[2], s2, sizeof(s2));
+		memcpy(bs.s[3], s3, sizeof(s3));
+	}
+
+	bs.next = 0;
+}
+
+static inline uint64_t xoshiroBulkNext(xoshiroBulkState &bs) {
+	if(bs.next == XOSHIRO_BUFFER) xoshiroBulkRefill(bs);
+	return bs.buffer[bs.next++];
+}
+
+//Fills out[0] ... out[n-1] with the next n 64-bit values
+void xoshiroFill(xoshiroBulkState &bs, uint64_t *out, size_t n) {
+	size_t i = 0;
+
+	while(i < n) {
+		size_t count;
+
+		if(bs.next == XOSHIRO_BUFFER) xoshiroBulkRefill(bs);
+		count = min(n - i, (size_t)(XOSHIRO_BUFFER - bs.next));
+		memcpy(out + i, bs.buffer + bs.next, count * sizeof(uint64_t));
+		bs.next += (int)count;
+		i += count;
+	}
+}
+
+//Fills out[0] ... out[n-1] with doubles uniformly distributed in [0, 1) (see randomUnit)
+void xoshiroFillUnit(xoshiroBulkState &bs, double *out, size_t n) {
+	size_t i = 0;
+
+	while(i < n) {
+		size_t count;
+
+		if(bs.next == XOSHIRO_BUFFER) xoshiroBulkRefill(bs);
+		count = min(n - i, (size_t)(XOSHIRO_BUFFER - bs.next));
+		//The shifted values fit in 53 bits, so the (faster) signed conversion gives the same result.
+		#pragma omp simd
+		for(size_t k = 0; k < count; k++) out[i + k] = (double)(int64_t)(bs.buffer[bs.next + k] >> 11) * 1.1102230246251565e-16;
+		bs.next += (int)count;
+		i += count;
+	}
+}
+
+/* The seed can instead be fixed (e.g., using the --seed option), so that runs can be reproduced exactly.
+ * The fixed seed is expanded into the xoshiro256** state using splitmix64 (as recommended by the xoshiro authors).
+ */
+static bool fixedSeedSet = false;
+static uint64_t fixedSeedValue;
+
+static inline uint64_t splitmix64(uint64_t &x) {
+	uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+	return z ^ (z >> 31);
+}
+
+void setFixedSeed(uint64_t value) {
+	fixedSeedSet = true;
+	fixedSeedValue = value;
+}
+
+//Parses a (hexadecimal, optionally prefixed by 0x) seed argument, as used by the --seed option. Returns false if this
+//isn't a valid seed.
+bool parseFixedSeed(const char *arg, uint64_t &value) {
+	const char *digits = arg;
+	char *end;
+	unsigned long long in;
+
+	//strtoull would also accept leading white space and a sign (so that "-1" would be taken as 0xffffffffffffffff)
+	if((digits[0] == '0') && ((digits[1] == 'x') || (digits[1] == 'X'))) digits += 2;
+	if(!isxdigit((unsigned char)digits[0])) return false;
+
+	errno = 0;
+	in = strtoull(arg, &end, 16);
+	if((errno != 0) || (end == arg) || (*end != '\0')) return false;
+	value = (uint64_t)in;
+	return true;
+}
+
 //This seeds using an external source
 //We use /dev/urandom here. 
 //We could alternately use the RdRand (or some other OS or HW source of pseudo-random numbers)
-void seed(uint64_t *xoshiro256starstarState){
+//If a fixed seed was set, the state is instead derived from the fixed seed; the different consumers of random
+//values within a run (e.g., the row and column permutation tests) request different streams.
+void seed(uint64_t *xoshiro256starstarState, uint64_t stream = 0){
 	FILE *infp;
 
+	if(fixedSeedSet) {
+		uint64_t x = fixedSeedValue ^ splitmix64(stream);
+		for(int i = 0; i < 4; i++) xoshiro256starstarState[i] = splitmix64(x);
+		return;
+	}
+
 	if((infp=fopen("/dev/urandom", "rb"))==NULL) {
 		perror("Can't open random source. Reverting to a deterministic seed.");
 		exit(-1);
@@ -611,12 +916,14 @@ void seed(uint64_t *xoshiro256starstarState){
   * This approach allows us to avoid _any_ modular reductions with high probability, and at worst case one
   * reduction. It's an opaque approach, but lovely.
   */
-uint64_t randomRange64(uint64_t s, uint64_t *xoshiro256starstarState){
+//The random 64-bit values are provided by next(), so this can be used with either the scalar or bulk generators.
+template <typename next_t>
+static inline uint64_t lemireRange64(uint64_t s, next_t next){
 	uint64_t x;
 	uint128_t m;
 	uint64_t l;
 
-	x = xoshiro256starstar(xoshiro256starstarState);
+	x = next();
 
 	if(UINT64_MAX == s) {
 		return x;
@@ -628,7 +935,7 @@ uint64_t randomRange64(uint64_t s, uint64_t *xoshiro256starstarState){
 		if(l<s) {
 			uint64_t t = ((uint64_t)(-s)) % s; //t = (2^64 - s) mod s (by definition of unsigned arithmetic in C)
 			while(l < t) {
-				x = xoshiro256starstar(xoshiro256starstarState);
+				x = next();
 				m = (uint128_t)x * (uint128_t)s;
 				l = (uint64_t)m; //This is m mod 2^64
 			}
@@ -638,6 +945,19 @@ uint64_t randomRange64(uint64_t s, uint64_t *xoshiro256starstarState){
 	}
 }
 
+uint64_t randomRange64(uint64_t s, uint64_t *xoshiro256starstarState){
+	return lemireRange64(s, [xoshiro256starstarState]() { return xoshiro256starstar(xoshiro256starstarState); });
+}
+
+uint64_t randomRange64(uint64_t s, xoshiroBulkState &bs){
+	return lemireRange64(s, [&bs]() { return xoshiroBulkNext(bs); });
+}
+
+//Fills out[0] ... out[n-1] with integers in the range [0, s] (see randomRange64)
+void xoshiroFillRange(xoshiroBulkState &bs, uint64_t s, uint64_t *out, size_t n) {
+	for(size_t i = 0; i < n; i++) out[i] = randomRange64(s, bs);
+}
+
 /*
  * This function produces a double that is uniformly distributed in the interval [0, 1).
  * Note that 2^53 is the largest integer that can be represented in a 64 bit IEEE 754 double, such that all 
@@ -651,6 +971,10 @@ double randomUnit(uint64_t *xoshiro256starstarState) {
 	return((xoshiro256starstar(xoshiro256starstarState) >> 11) * 1.1102230246251565e-16);
 }
 
+double randomUnit(xoshiroBulkState &bs) {
+	return((xoshiroBulkNext(bs) >> 11) * 1.1102230246251565e-16);
+}
+
 // Fisher-Yates Fast (in place) shuffle algorithm
 void FYshuffle(uint8_t data[], uint8_t rawdata[], const int sample_size, uint64_t *xoshiro256starstarState) {
 	long int r;
@@ -664,6 +988,17 @@ void FYshuffle(uint8_t data[], uint8_t rawdata[], const int sample_size, uint64_
 	}
 }
 
+// Each caller owns its generator and its buffers (e.g., each permutation test thread), so no lock is needed
+void FYshuffle(uint8_t data[], uint8_t rawdata[], const int sample_size, xoshiroBulkState &bs) {
+	long int r;
+
+	for (long int i = sample_size - 1; i > 0; --i) {
+		r = (long int)randomRange64((uint64_t)i, bs);
+		SWAP(data[r], data[i]);
+		SWAP(rawdata[r], rawdata[i]);
+	}
+}
+
 // Quick sum array  // TODO
 long int sum(const uint8_t arr[], const int sample_size) {
 	long int sum = 0;
@@ -747,12 +1082,78 @@ void map_init(map<pair<uint8_t, uint8_t>, int> &m) {
 	}
 }
 
+//Inputs at least this long are counted in parallel.
+#define HISTOGRAM_PARALLEL_MIN (1L << 20)
+
+/* Counts the number of occurrences of each symbol (which must be less than alph_size) in data[0] ... data[len-1]
+ * into counts[0] ... counts[alph_size-1].
+ * When one symbol dominates, a single counter table results in a chain of dependent increments to the same counter,
+ * so the symbols are counted into 4 interleaved tables which are then added together. Binary data is counted
+ * by summing the symbols (which compiles to vector instructions).
+ */
+static void histogramBlock(const uint8_t *data, long len, int alph_size, long *counts){
+	long sub[4][256];
+	long i;
+
+	assert((alph_size >= 1) && (alph_size <= 256));
+
+	if(alph_size == 2){
+		long ones = 0;
+		for(i = 0; i < len; i++) ones += data[i];
+		assert(ones <= len);
+		counts[0] = len - ones;
+		counts[1] = ones;
+		return;
+	}
+
+	for(int j = 0; j < 4; j++){
+		for(int k = 0; k < alph_size; k++) sub[j][k] = 0;
+	}
+
+	for(i = 0; i + 3 < len; i += 4){
+		sub[0][data[i]]++;
+		sub[1][data[i+1]]++;
+		sub[2][data[i+2]]++;
+		sub[3][data[i+3]]++;
+	}
+	for(; i < len; i++) sub[0][data[i]]++;
+
+	for(int k = 0; k < alph_size; k++) counts[k] = sub[0][k] + sub[1][k] + sub[2][k] + sub[3][k];
+}
+
+void histogram(const uint8_t *data, long len, int alph_size, long *counts){
+	for(int k = 0; k < alph_size; k++) counts[k] = 0;
+
+	if(len < HISTOGRAM_PARALLEL_MIN){
+		histogramBlock(data, len, alph_size, counts);
+		return;
+	}
+
+	#pragma omp parallel
+	{
+		const int nthreads = omp_get_num_threads();
+		const int t = omp_get_thread_num();
+		const long start = (len / nthreads) * t;
+		const long end = (t == nthreads - 1) ? len : start + (len / nthreads);
+		long localCounts[256];
+
+		histogramBlock(data + start, end - start, alph_size, localCounts);
+
+		#pragma omp critical(histogram)
+		{
+			for(int k = 0; k < alph_size; k++) counts[k] += localCounts[k];
+		}
+	}
+}
+
 // Calculates proportions of each value as an index
 void calc_proportions(const uint8_t data[], vector<double> &p, const int sample_size) {
 	unsigned int symbolNumber = p.size();
-	
-	for (int i = 0; i < sample_size; i++) {
-		p[data[i]] ++;
+	long counts[256];
+
+	histogram(data, sample_size, symbolNumber, counts);
+	for (unsigned int i = 0; i < symbolNumber; i++) {
+		p[i] += (double)counts[i];
 	}
 
 	//p now contains symbol counts. Normalize to the per-symbol probability
@@ -763,8 +1164,11 @@ void calc_proportions(const uint8_t data[], vector<double> &p, const int sample_
 
 // Calculates proportions of each value as an index
 void calc_counts(const uint8_t data[], vector<int> &c, const int sample_size) {
-	for (int i = 0; i < sample_size; i++) {
-		c[data[i]] ++;
+	long counts[256];
+
+	histogram(data, sample_size, c.size(), counts);
+	for (unsigned int i = 0; i < c.size(); i++) {
+		c[i] += (int)counts[i];
 	}
 }
 
@@ -846,6 +1250,8 @@ double prediction_estimate_function(long double p, long r, long N){
 
 	q = 1.0L-p;
 	x = 1.0L;
+	//q*p^r doesn't depend on x, so it is only calculated once
+	const long double qpr = q*powl(p, r);
 
 	//We know that 
 	// * x is in the interval [1,1/p] which is a subset of [1,k]
@@ -853,7 +1259,7 @@ double prediction_estimate_function(long double p, long r, long N){
 	//As such we don't need much fancyness for looking for "equality"
 	for(int i = 0; (i <= 65) && ((x - xlast) > (LDBL_EPSILON*x)); i++) {
 		xlast = x;
-		x = 1.0L + q*powl(p, r)*powl(x, r+1.0L);
+		x = 1.0L + qpr*powl(x, r+1.0L);
 		//We expect this convergence to be monotonic up.
 		assert(x >= xlast);
 		//We expect x<=1/p
@@ -992,12 +1398,136 @@ double predictionEstimate(long C, long N, long max_run_len, long k, const char *
 	return entEst;
 }
 
-//The idea here is that we've given an array of pointers (binaryDict). 
+/* Several of the prediction estimates run a set of sub-predictors side by side (e.g., the MultiMCW windows, or the
+ * MultiMMC depths) which only interact through the scoreboard. These tests first compute the result streams for
+ * each sub-predictor (which can be done independently), and then replay the scoreboard using the following.
+ * The streams are processed in groups of (up to) 64 predictions: bit t of predicted[k] is set if sub-predictor k made
+ * a prediction for the t-th sample of the group, and bit t of correct[k] is set if that prediction was also correct.
+ */
+//The number of samples processed at a time; each of the sub-predictors' streams is computed for this many samples.
+#define PREDICTOR_CHUNK 65536
+
+struct predictorScoreboard {
+   long scoreboard[64];
+   int count;
+   int winner;
+   long C;
+   long run_len;
+   long max_run_len;
+};
+
+static void initPredictorScoreboard(predictorScoreboard &sb, int count)
+{
+   assert((count > 0) && (count <= 64));
+   sb.count = count;
+   for(int k=0; k<count; k++) sb.scoreboard[k] = 0;
+   sb.winner = 0;
+   sb.C = 0;
+   sb.run_len = 0;
+   sb.max_run_len = 0;
+}
+
+//Account for n consecutive predictions, where bit t of "correct" is set if the t-th of these was correct.
+static inline void accumulateRuns(uint64_t correct, int n, long &run_len, long &max_run_len)
+{
+   const uint64_t valid = (n == 64) ? UINT64_MAX : ((1ULL << n) - 1);
+   uint64_t x;
+   long longest;
+
+   assert((n > 0) && (n <= 64));
+   correct &= valid;
+
+   if(correct == valid) {
+      run_len += n;
+      if(run_len > max_run_len) max_run_len = run_len;
+      return;
+   }
+
+   // The leading run continues the current run
+   run_len += __builtin_ctzll(~correct);
+   if(run_len > max_run_len) max_run_len = run_len;
+
+   // Runs entirely within this group (each round of x &= x>>1 shortens every run by one)
+   if(__builtin_popcountll(correct) > max_run_len) {
+      for(x = correct, longest = 0; x != 0; longest++) x &= x >> 1;
+      if(longest > max_run_len) max_run_len = longest;
+   }
+
+   // The trailing run becomes the current run
+   run_len = n - 1 - (63 - __builtin_clzll(~correct & valid));
+}
+
+//Replay the scoreboard for a group of n predictions. Only the low n bits of the masks are used.
+//For each sample, the current winner's prediction is checked, and then the sub-predictors that were correct
+//are credited in order; a sub-predictor takes over as the winner if its score is at least the winner's score.
+static void replayScoreboard(predictorScoreboard &sb, const uint64_t *predicted, const uint64_t *correct, int n)
+{
+   const uint64_t valid = (n == 64) ? UINT64_MAX : ((1ULL << n) - 1);
+   bool fixedWinner;
+   int k;
+
+   assert((n > 0) && (n <= 64));
+
+   //If the winner predicts every sample in the group and none of the others could catch up with it,
+   //then the winner can't change during this group.
+   fixedWinner = ((predicted[sb.winner] & valid) == valid);
+   for(k=0; fixedWinner && (k<sb.count); k++) {
+      if((k != sb.winner) && (sb.scoreboard[k] + __builtin_popcountll(correct[k] & valid) >= sb.scoreboard[sb.winner])) fixedWinner = false;
+   }
+
+   if(fixedWinner) {
+      sb.C += __builtin_popcountll(correct[sb.winner] & valid);
+      accumulateRuns(correct[sb.winner], n, sb.run_len, sb.max_run_len);
+      for(k=0; k<sb.count; k++) sb.scoreboard[k] += __builtin_popcountll(correct[k] & valid);
+      return;
+   }
+
+   for(int t=0; t<n; t++) {
+      // test prediction of winner
+      if((predicted[sb.winner] >> t) & 1) {
+         if((correct[sb.winner] >> t) & 1) {
+            sb.C++;
+            if(++sb.run_len > sb.max_run_len) sb.max_run_len = sb.run_len;
+         } else {
+            sb.run_len = 0;
+         }
+      }
+
+      // update scoreboard and select new winner
+      for(k=0; k<sb.count; k++) {
+         if((correct[k] >> t) & 1) {
+            if(++sb.scoreboard[k] >= sb.scoreboard[sb.winner]) sb.winner = k;
+         }
+      }
+   }
+}
+
+//Replay the scoreboard for a chunk of n predictions, where the sub-predictor k's streams are in predicted[k] and correct[k].
+static void replayScoreboardChunk(predictorScoreboard &sb, const vector<uint64_t> *predicted, const vector<uint64_t> *correct, long n)
+{
+   uint64_t blockPredicted[64], blockCorrect[64];
+
+   for(long b=0; b<n; b+=64) {
+      for(int k=0; k<sb.count; k++) {
+         blockPredicted[k] = predicted[k][b>>6];
+         blockCorrect[k] = correct[k][b>>6];
+      }
+      replayScoreboard(sb, blockPredicted, blockCorrect, (n-b >= 64) ? 64 : (int)(n-b));
+   }
+}
+
+//The idea here is that all the binary dictionaries share one table (binaryDict).
 //We are trying to produce the address of the length-2 array associated with the length-d prefix "b".
-// array The dth index is d-1, so we first find the start of the address space (binaryDict[(d)-1])
+//There are 2^j patterns of length j, each associated with a length-2 array, so the length-d prefixes start
+//after 2^2 + ... + 2^d = 2^(d+1) - 4 counters. This way, the (hot) short prefixes are packed together at the
+//start of the table, so they tend to stay in cache.
 //We take the least significant d bits from "b": this is the expression "(b) & ((1U << (d)) - 1)"
 //We then multiply this by 2 (as each pattern is associated with a length-2 array) by left shifting by 1.
-#define BINARYDICTLOC(d, b) (binaryDict[(d)-1] + (((b) & ((1U << (d)) - 1))<<1))
+#define BINARYDICTLOC(d, b) (binaryDict + (1U << ((d)+1)) - 4 + (((b) & ((1U << (d)) - 1))<<1))
+//The number of counters needed for the prefixes of length 1 through D
+#define BINARYDICTSIZE(D) ((1U << ((D)+2)) - 4)
+//Prefixes of at least this length are prefetched one bit ahead
+#define BINARYDICTPREFETCH 10
 
 static uint32_t compressedBitSymbols(const uint8_t *S, long length)
 {
@@ -1016,7 +1546,32 @@ static uint32_t compressedBitSymbols(const uint8_t *S, long length)
    return retPattern;
 }
 
-static void printVersion(string name) {
+//Pack a bitstring (one bit per byte) into 64-bit words; S[i] goes into bit (i&63) of packed[i>>6].
+//One extra zero word is appended, so that any 64 bits starting in the string can be read using extractBits.
+static void packBits(const uint8_t *S, long L, vector<uint64_t> &packed)
+{
+   long i;
+
+   packed.assign((L>>6) + 2, 0);
+
+   for(i=0; i+64<=L; i+=64) {
+      uint64_t word = 0;
+      for(int t=0; t<64; t++) word |= ((uint64_t)(S[i+t]&1)) << t;
+      packed[i>>6] = word;
+   }
+
+   for(; i<L; i++) packed[i>>6] |= ((uint64_t)(S[i]&1)) << (i&63);
+}
+
+//The 64 bits starting at bit position "start" of a packBits string. Positions prior to the string are read as 0.
+static inline uint64_t extractBits(const uint64_t *packed, long start)
+{
+   if(start < 0) return (start <= -64) ? 0 : (packed[0] << (-start));
+   else if((start & 63) == 0) return packed[start>>6];
+   else return (packed[start>>6] >> (start&63)) | (packed[(start>>6)+1] << (64-(start&63)));
+}
+
+void printVersion(string name) {
     cout << name << " " << VERSION << "\n\n";
     cout << "Disclaimer: ";
     cout << "NIST-developed software is provided by NIST as a public service. You may use, copy, and distribute copies of the software in any medium, provided that you keep intact this entire notice. You may improve, modify, and create derivative works of the software or any portion of the software, and you may copy and distribute such modifications or works. Modified works should carry a notice stating that you changed the software and should note the date and nature of any such change. Please explicitly acknowledge the National Institute of Standards and Technology as the source of the software.";
@@ -1027,7 +1582,7 @@ static void printVersion(string name) {
     cout << "\n\n";
 }
 
-static string recreateCommandLine(int argc, char* argv[]) {
+string recreateCommandLine(int argc, char* argv[]) {
     string commandLine = "";
     for(int i = 0; i < argc; ++i) {
         commandLine.append(argv[i]);
@@ -1038,35 +1593,208 @@ static string recreateCommandLine(int argc, char* argv[]) {
     return commandLine;
 }
 
-class PostfixDictionary {
-	map<uint8_t, long> postfixes;
-	long curBest;
-	uint8_t curPrediction;
-public:
-	PostfixDictionary() { curBest = 0; curPrediction = 0;}
-	uint8_t predict(long &count) {assert(curBest > 0); count = curBest; return curPrediction;}
-	bool incrementPostfix(uint8_t in, bool makeNew) {
-		map<uint8_t, long>::iterator curp = postfixes.find(in);
-		long curCount;
-		bool newEntry=false;
+//The last (up to) 16 symbols prior to a position, packed into a uint128_t with the most recent symbol in the low byte.
+//The length-j context is the low j bytes, so the nested contexts used by the predictors are all masks of the same
+//value, and the value for the next position is (window << 8) | (the new symbol).
+static inline uint128_t contextWindow(const uint8_t *end, int length) {
+	uint128_t window = 0;
+
+	assert((length >= 0) && (length <= 16));
+	for(int j=length; j>0; j--) window = (window << 8) | end[-j];
+
+	return window;
+}
+
+static inline uint128_t contextMask(int length) {
+	assert((length > 0) && (length <= 16));
+	return (length == 16) ? UINT128_MAX : ((((uint128_t)1) << (8*length)) - 1);
+}
+
+//The dictionary used by the MultiMMC and LZ78Y predictors, for contexts produced by contextWindow (and contextMask).
+//For each context x, this tracks the counts of each (x,y) pair, and the postfix y with the largest count (ties go to the
+//larger symbol). Contexts live in an open-addressing hash table. The first few postfixes of each context are stored inline
+//in the entry; any further postfixes (which only happen for short contexts) go into a second open-addressing table keyed
+//by (entry, postfix).
+#define CONTEXT_INLINE_POSTFIXES 3
+
+class ContextDictionary {
+	struct ContextEntry {
+		uint128_t context;
+		long curBest;
+		long inlineCounts[CONTEXT_INLINE_POSTFIXES];
+		uint8_t inlinePostfixes[CONTEXT_INLINE_POSTFIXES];
+		uint8_t inlineUsed;
+		uint8_t curPrediction;
+		bool hasOverflow;
+	};
+
+	struct OverflowPostfix {
+		uint64_t key; //((entry+1) << 8) | postfix, or 0 for an empty slot
+		long count;
+	};
+
+	vector<ContextEntry> entries;
+	vector<uint64_t> slots; //(hash tag << 32) | (entry+1), or 0 for an empty slot
+	vector<OverflowPostfix> overflow;
+	size_t overflowUsed;
+
+	static inline uint64_t contextHash(uint128_t context) {
+		uint64_t h = ((uint64_t)context * 0x9E3779B97F4A7C15ULL) ^ ((uint64_t)(context >> 64) * 0xC2B2AE3D27D4EB4FULL);
+		h ^= h >> 32;
+		h *= 0xD6E8FEB86659FD93ULL;
+		return h ^ (h >> 32);
+	}
+
+	static inline uint64_t postfixHash(uint64_t key) {
+		uint64_t h = key * 0x9E3779B97F4A7C15ULL;
+		return h ^ (h >> 29);
+	}
+
+	void growSlots() {
+		vector<uint64_t> oldSlots(slots.size() * 2, 0);
+		size_t mask = oldSlots.size() - 1;
+
+		oldSlots.swap(slots);
+		for(size_t i=0; i<oldSlots.size(); i++) {
+			if(oldSlots[i] != 0) {
+				size_t loc = contextHash(entries[(uint32_t)oldSlots[i] - 1].context) & mask;
+				while(slots[loc] != 0) loc = (loc + 1) & mask;
+				slots[loc] = oldSlots[i];
+			}
+		}
+	}
+
+	void growOverflow() {
+		vector<OverflowPostfix> oldOverflow(overflow.size() * 2);
+		size_t mask = oldOverflow.size() - 1;
+
+		for(size_t i=0; i<oldOverflow.size(); i++) oldOverflow[i].key = 0;
+		oldOverflow.swap(overflow);
+		for(size_t i=0; i<oldOverflow.size(); i++) {
+			if(oldOverflow[i].key != 0) {
+				size_t loc = postfixHash(oldOverflow[i].key) & mask;
+				while(overflow[loc].key != 0) loc = (loc + 1) & mask;
+				overflow[loc] = oldOverflow[i];
+			}
+		}
+	}
+
+	//Returns the count location for the postfix, or NULL if it isn't present (and can't be made)
+	long *postfixCount(ContextEntry &entry, long entryIndex, uint8_t in, bool makeNew, bool &newEntry) {
+		newEntry = false;
+
+		for(int j=0; j<entry.inlineUsed; j++) {
+			if(entry.inlinePostfixes[j] == in) return &(entry.inlineCounts[j]);
+		}
+
+		if(entry.hasOverflow || (makeNew && (entry.inlineUsed == CONTEXT_INLINE_POSTFIXES))) {
+			uint64_t key = (((uint64_t)entryIndex + 1) << 8) | in;
+			size_t mask = overflow.size() - 1;
+			size_t loc = postfixHash(key) & mask;
+
+			while((overflow[loc].key != 0) && (overflow[loc].key != key)) loc = (loc + 1) & mask;
+			if(overflow[loc].key == key) return &(overflow[loc].count);
+			if(!makeNew) return NULL;
 
-		if(curp != postfixes.end()) {
-			//The entry is already there. We always increment in this case.
-			curCount = ++(curp->second);
-		} else if(makeNew) {
-			//The entry is not here, but we are allowed to create a new entry
 			newEntry = true;
-			curCount = postfixes[in] = 1;
-		} else {
-			//The entry is not here, we are not allowed to create a new entry
-			return false;
+			entry.hasOverflow = true;
+			if(2*(overflowUsed+1) > overflow.size()) {
+				growOverflow();
+				return postfixCount(entry, entryIndex, in, makeNew, newEntry);
+			}
+			overflowUsed++;
+			overflow[loc].key = key;
+			overflow[loc].count = 0;
+			return &(overflow[loc].count);
+		}
+
+		if(!makeNew) return NULL;
+
+		newEntry = true;
+		entry.inlinePostfixes[entry.inlineUsed] = in;
+		entry.inlineCounts[entry.inlineUsed] = 0;
+		return &(entry.inlineCounts[entry.inlineUsed++]);
+	}
+
+public:
+	ContextDictionary() : slots(1024, 0), overflowUsed(0) {
+		overflow.resize(256);
+		for(size_t i=0; i<overflow.size(); i++) overflow[i].key = 0;
+	}
+
+	//Returns the entry index for the context, or -1 if the context isn't present.
+	long find(uint128_t context) const {
+		uint64_t h = contextHash(context);
+		size_t mask = slots.size() - 1;
+		size_t loc = h & mask;
+
+		while(slots[loc] != 0) {
+			if(((slots[loc] >> 32) == (h >> 32)) && (entries[(uint32_t)slots[loc] - 1].context == context)) {
+				return (long)((uint32_t)slots[loc]) - 1;
+			}
+			loc = (loc + 1) & mask;
+		}
+
+		return -1;
+	}
+
+	//Returns the entry index for the context, adding it (with no postfixes) if it isn't present.
+	long findOrCreate(uint128_t context) {
+		long entryIndex = find(context);
+
+		if(entryIndex < 0) {
+			ContextEntry newEntry;
+			uint64_t h;
+			size_t mask;
+			size_t loc;
+
+			assert(entries.size() < UINT32_MAX);
+			newEntry.context = context;
+			newEntry.curBest = 0;
+			newEntry.inlineUsed = 0;
+			newEntry.curPrediction = 0;
+			newEntry.hasOverflow = false;
+			entries.push_back(newEntry);
+			entryIndex = (long)entries.size() - 1;
+
+			if(2*entries.size() > slots.size()) growSlots();
+
+			h = contextHash(context);
+			mask = slots.size() - 1;
+			loc = h & mask;
+			while(slots[loc] != 0) loc = (loc + 1) & mask;
+			slots[loc] = (h & 0xFFFFFFFF00000000ULL) | (uint64_t)(entryIndex + 1);
 		}
 
+		return entryIndex;
+	}
+
+	//Returns the most common postfix seen for this context (and its count)
+	uint8_t predict(long entryIndex, long &count) const {
+		const ContextEntry &entry = entries[entryIndex];
+
+		assert(entry.curBest > 0);
+		count = entry.curBest;
+		return entry.curPrediction;
+	}
+
+	//Counts the (x,in) pair, if it is present or if makeNew is set. Returns true if a new (x,in) pair was added.
+	bool incrementPostfix(long entryIndex, uint8_t in, bool makeNew) {
+		ContextEntry &entry = entries[entryIndex];
+		bool newEntry;
+		long *countp = postfixCount(entry, entryIndex, in, makeNew, newEntry);
+		long curCount;
+
+		//The entry is not here, we are not allowed to create a new entry
+		if(countp == NULL) return false;
+
 		//Only instances where curCount is set and an increment was performed get here
-		if((curCount > curBest) || ((curCount == curBest) && (in > curPrediction))) { 
-			curPrediction = in; 
-			curBest = curCount; 
-		} 
+		curCount = ++(*countp);
+
+		if((curCount > entry.curBest) || ((curCount == entry.curBest) && (in > entry.curPrediction))) {
+			entry.curPrediction = in;
+			entry.curBest = curCount;
+		}
 
 		return newEntry;
 	}
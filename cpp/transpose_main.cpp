@@ -1,7 +1,6 @@
-/* VERSION information is kept in utils.h. Please update when a new version is released */
+/* VERSION information is kept in shared/data.h. Please update when a new version is released */
 
-#include "shared/utils.h"
-#include "iid/iid_test_run.h"
+#include "lib/entropy_assessment.h"
 #include <stdio.h>
 #include <cstdlib>
 #include <limits>